@@ -14,6 +14,8 @@ Available environment variables:
 * PHOEBE_MULTIPROC_NPROCS=INT (number of proces to use within multiprocessing.  Multiprocessing is used for solver that support it and when sampling over a distribution in run_compute if MPI is not in use.  Set to 0 to disable multiprocessing and force serial.  Defaults to number of CPUs available.)
 * PHOEBE_PBDIR (directory to search for passbands, in addition to phoebe.list_passband_directories())
 * PHOEBE_DEVEL=TRUE/FALSE enable developer mode by default
+* PHOEBE_MESH_CACHE_DIR (directory in which to cache meshes across sessions.  Defaults to None which disables the cache, can override in python with phoebe.conf.mesh_cache_on(dir) and phoebe.conf.mesh_cache_off())
+* PHOEBE_MESH_CACHE_MAXSIZE=INT (maximum size of the mesh cache in MB, least recently used meshes are removed beyond this.  Defaults to 1024)
 
 """
 
@@ -254,6 +256,9 @@ class Settings(object):
         # And we'll require explicitly setting developer mode on
         self._devel = _env_variable_bool('PHOEBE_DEVEL', False)
 
+        self._mesh_cache_dir = _os.getenv('PHOEBE_MESH_CACHE_DIR', None)
+        self._mesh_cache_maxsize = _env_variable_int('PHOEBE_MESH_CACHE_MAXSIZE', 1024)
+
     def __repr__(self):
         return "<Settings interactive_checks={} interactive_constraints={}>".format(self.interactive_checks, self.interactive_constraints)
 
@@ -362,6 +367,32 @@ class Settings(object):
     def progressbars(self):
         return self._progressbars
 
+    def mesh_cache_on(self, cache_dir):
+        """
+        Cache meshes in `cache_dir` so that they can be reused across sessions
+        (and processes).
+        """
+        self._mesh_cache_dir = _os.path.abspath(_os.path.expanduser(cache_dir))
+
+    def mesh_cache_off(self):
+        self._mesh_cache_dir = None
+
+    def mesh_cache_set_maxsize(self, value):
+        """
+        Set the maximum size (in MB) of the mesh cache.
+        """
+        if not isinstance(value, int):
+            raise TypeError("must be integer")
+        self._mesh_cache_maxsize = value
+
+    @property
+    def mesh_cache_dir(self):
+        return self._mesh_cache_dir
+
+    @property
+    def mesh_cache_maxsize(self):
+        return self._mesh_cache_maxsize
+
 conf = Settings()
 
 ###############################################################################
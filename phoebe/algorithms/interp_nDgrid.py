@@ -41,36 +41,8 @@ def create_pixeltypegrid(grid_pars, grid_data):
     @rtype: array, array
     """
 
-    uniques = [np.unique(column, return_inverse=True) for column in grid_pars]
-    #[0] are the unique values, [1] the indices for these to recreate the original array
-
-    # we need to copy the values of the unique axes explicitly into new arrays
-    # otherwise we can get issues with the interpolator
-    axis_values = []
-    for uniques_ in uniques:
-        this_axes = np.zeros(len(uniques_[0]))
-        this_axes[:] = uniques_[0]
-        axis_values.append(this_axes)
-    #axis_values = [uniques_[0] for uniques_ in uniques]
-    #axis_values = [np.require(uniques_[0],requirements=['A','O','W','F']) for uniques_ in uniques]
-
-    unique_val_indices = [uniques_[1] for uniques_ in uniques]
-
-    data_dim = np.shape(grid_data)[0]
-
-    par_dims   = [len(uv[0]) for uv in uniques]
-
-    par_dims.append(data_dim)
-    pixelgrid = np.ones(par_dims)
-
-    # We put np.inf as default value. If we get an inf, that means we tried to access
-    # a region of the pixelgrid that is not populated by the data table
-    pixelgrid[pixelgrid==1] = np.inf
-
-    # now populate the multiDgrid
-    indices = [uv[1] for uv in uniques]
-    pixelgrid[indices] = grid_data.T
-    return tuple(axis_values), pixelgrid
+    axis_values, pixelgrid = libphoebe.interp_grid(grid_pars, grid_data)
+    return axis_values, pixelgrid
 
 
 def interpolate(p, axis_values, pixelgrid, order=1, mode='constant', cval=0.0):
@@ -101,7 +73,7 @@ def interpolate(p, axis_values, pixelgrid, order=1, mode='constant', cval=0.0):
                 for i in range(np.shape(pixelgrid)[-1])]
 
 
-def cinterpolate(p, axis_values, pixelgrid):
+def cinterpolate(p, axis_values, pixelgrid, order=1, kind='bspline'):
     """
     Interpolates in a grid prepared by create_pixeltypegrid().
 
@@ -112,15 +84,64 @@ def cinterpolate(p, axis_values, pixelgrid):
     Careful, the shape of input :envvar:`p` and output is the transpose of
     :py:func:`interpolate`.
 
+    With order=3 the grid is interpolated by the cubic kernel given by kind
+    (see :py:func:`cprepare_cubic`) and points out of the grid are nan.  The
+    interpolation is prepared on every call, so when interpolating in the
+    same grid repeatedly use :py:func:`cprepare_cubic` and
+    :py:func:`ccubic_interpolate` instead.
+
     @param p: Ninterpolate X Npar array
     @type p: array
+    @param order: 1 (linear) or 3 (cubic)
+    @type order: int
+    @param kind: kernel of the cubic interpolation, 'bspline' or 'catmull-rom'
+    @type kind: str
     @return: Ninterpolate X Ndata array
     @rtype: array
     """
-    res = libphoebe.interp(p, axis_values, pixelgrid)
+    if order == 1:
+        res = libphoebe.interp(p, axis_values, pixelgrid)
+    elif order == 3:
+        res = ccubic_interpolate(p, cprepare_cubic(axis_values, pixelgrid, kind=kind))
+    else:
+        raise ValueError("order must be 1 or 3, not {}".format(order))
     return res
 
 
+def cprepare_cubic(axis_values, pixelgrid, kind='bspline'):
+    """
+    Prepares cubic interpolation in a grid prepared by create_pixeltypegrid().
+
+    For kind='bspline' the grid is prefiltered into cubic B-spline
+    coefficients once, so that the returned handle can be evaluated
+    repeatedly by :py:func:`ccubic_interpolate` without the per-call
+    prefilter of scipy.ndimage. kind='catmull-rom' needs no prefilter.
+    The grid should not contain missing (nan/inf) values, see
+    libphoebe.interp_impute.
+
+    @param kind: 'bspline' (C2 smooth) or 'catmull-rom' (C1 smooth)
+    @type kind: str
+    @return: handle of the interpolation
+    @rtype: capsule
+    """
+    return libphoebe.cubic_interp_setup(tuple(axis_values), pixelgrid, kind=kind.encode())
+
+
+def ccubic_interpolate(p, interpolator):
+    """
+    Interpolates with the handle prepared by :py:func:`cprepare_cubic`.
+
+    Same shapes as in :py:func:`cinterpolate`, points out of the grid
+    are nan.
+
+    @param p: Ninterpolate X Npar array
+    @type p: array
+    @return: Ninterpolate X Ndata array
+    @rtype: array
+    """
+    return libphoebe.cubic_interp_eval(interpolator, p)
+
+
 if __name__ == "__main__":
 
     # mock data
@@ -468,8 +468,10 @@ class Passband:
                 if 'blackbody:Inorm' in self.content:
                     self._bb_func_energy = (hdul['bb_func'].data['teff'], hdul['bb_func'].data['logi_e'], 3)
                     self._bb_func_photon = (hdul['bb_func'].data['teff'], hdul['bb_func'].data['logi_p'], 3)
-                    self._log10_Inorm_bb_energy = lambda Teff: interpolate.splev(Teff, self._bb_func_energy)
-                    self._log10_Inorm_bb_photon = lambda Teff: interpolate.splev(Teff, self._bb_func_photon)
+                    self._bb_spline_energy = libphoebe.bspline_setup(*self._bb_func_energy)
+                    self._bb_spline_photon = libphoebe.bspline_setup(*self._bb_func_photon)
+                    self._log10_Inorm_bb_energy = lambda Teff: libphoebe.bspline_eval(self._bb_spline_energy, Teff)
+                    self._log10_Inorm_bb_photon = lambda Teff: libphoebe.bspline_eval(self._bb_spline_photon, Teff)
 
                 if 'blackbody:ext' in self.content:
                     self._bb_extinct_axes = (np.array(list(hdul['bb_teffs'].data['teff'])), np.array(list(hdul['bb_ebvs'].data['ebv'])), np.array(list(hdul['bb_rvs'].data['rv'])))
@@ -642,7 +644,7 @@ class Passband:
         effective temperatures. It does this for two regimes, energy-weighted
         and photon-weighted. It then fits a cubic spline to the log(I)-Teff
         values and exports the interpolation functions _log10_Inorm_bb_energy
-        and _log10_Inorm_bb_photon.
+        and _log10_Inorm_bb_photon, evaluated natively by libphoebe.bspline_eval.
 
         Arguments
         ----------
@@ -658,31 +660,32 @@ class Passband:
         # Energy-weighted intensities:
         log10ints_energy = np.array([np.log10(self._bb_intensity(Teff, photon_weighted=False)) for Teff in Teffs])
         self._bb_func_energy = interpolate.splrep(Teffs, log10ints_energy, s=0)
-        self._log10_Inorm_bb_energy = lambda Teff: interpolate.splev(Teff, self._bb_func_energy)
+        self._bb_spline_energy = libphoebe.bspline_setup(*self._bb_func_energy)
+        self._log10_Inorm_bb_energy = lambda Teff: libphoebe.bspline_eval(self._bb_spline_energy, Teff)
 
         # Photon-weighted intensities:
         log10ints_photon = np.array([np.log10(self._bb_intensity(Teff, photon_weighted=True)) for Teff in Teffs])
         self._bb_func_photon = interpolate.splrep(Teffs, log10ints_photon, s=0)
-        self._log10_Inorm_bb_photon = lambda Teff: interpolate.splev(Teff, self._bb_func_photon)
+        self._bb_spline_photon = libphoebe.bspline_setup(*self._bb_func_photon)
+        self._log10_Inorm_bb_photon = lambda Teff: libphoebe.bspline_eval(self._bb_spline_photon, Teff)
 
         if 'blackbody:Inorm' not in self.content:
             self.content.append('blackbody:Inorm')
 
     def impute_atmosphere_grid(self, grid):
         """
-        This function imputes the passed atmosphere grid by linear N-D interpolation.
+        This function imputes the passed atmosphere grid by linear interpolation
+        along the grid axes (see libphoebe.interp_impute). Missing nodes that
+        cannot be bracketed by valid nodes along any axis remain NaN.
         As grid is passed by reference, it is not necessary to re-assign the table to
         the return value of this function; the return value is provided for convenience
         only, but the grid is changed in place.
         """
 
-        valid_mask = ~np.isnan(grid[...,0])
-        coords = np.array(np.nonzero(valid_mask)).T
-        values = grid[valid_mask][:,0]
-        it = interpolate.LinearNDInterpolator(coords, values, fill_value=0)
-        filled = it(list(np.ndindex(grid[...,0].shape))).reshape(grid[...,0].shape)
-        filled[filled==0] = np.nan
-        grid[...,0] = filled
+        filled = np.ascontiguousarray(grid, dtype=np.float64)
+        libphoebe.interp_impute(filled)
+        if filled is not grid:
+            grid[...] = filled
         return grid
 
     def compute_bb_reddening(self, Teffs=None, Ebv=None, Rv=None, verbose=False):
@@ -1782,6 +1785,45 @@ class Passband:
         if 'phoenix:ldint' not in self.content:
             self.content.append('phoenix:ldint')
 
+    # offsets of the LD model coefficients in the ld tables; see
+    # <phoebe.atmospheres.passbands.Passband.compute_ck2004_ldcoeffs>
+    _ld_lookup_offsets = {'linear': 0, 'logarithmic': 1, 'square_root': 3, 'quadratic': 5, 'power': 7}
+
+    def _ld_lookup(self, ldatm, ld_func, photon_weighted=False, cache_key=None):
+        """
+        Internal function that returns a libphoebe handle for looking up
+        limb darkening coefficients of `ld_func` in the `ldatm` table and
+        evaluating the LD law natively (see libphoebe.ld_lookup_D and
+        libphoebe.ld_lookup_ldint). The handle caches the coefficients per
+        triangle, so callers should pass a `cache_key` unique to the mesh
+        (e.g. the component) to reuse the coefficients across epochs.
+
+        Returns
+        --------
+        * handle or None if the table or `ld_func` is not available.
+        """
+        if ld_func not in self._ld_lookup_offsets or '{}:ld'.format(ldatm) not in self.content:
+            return None
+
+        if ldatm == 'ck2004':
+            axes = self._ck2004_intensity_axes
+            table = self._ck2004_ld_photon_grid if photon_weighted else self._ck2004_ld_energy_grid
+        elif ldatm == 'phoenix':
+            axes = self._phoenix_intensity_axes
+            table = self._phoenix_ld_photon_grid if photon_weighted else self._phoenix_ld_energy_grid
+        else:
+            return None
+
+        if not hasattr(self, '_ld_lookups'):
+            self._ld_lookups = {}
+
+        key = (ldatm, ld_func, photon_weighted, cache_key)
+        if key not in self._ld_lookups or self._ld_lookups[key][0] is not table:
+            # the table is kept to detect recomputed coefficients:
+            self._ld_lookups[key] = (table, libphoebe.ld_lookup_setup(tuple(axes[0:3]), table, _bytes(ld_func), self._ld_lookup_offsets[ld_func]))
+
+        return self._ld_lookups[key][1]
+
     def interpolate_ldcoeffs(self, Teff=5772., logg=4.43, abun=0.0,
                                     ldatm='ck2004', ld_func='power',
                                     photon_weighted=False):
@@ -1832,14 +1874,14 @@ class Passband:
 
         if not hasattr(Teff, '__iter__'):
             req = np.array(((Teff, logg, abun),))
-            ld_coeffs = libphoebe.interp(req, axes[0:3], table)[0]
+            ld_coeffs, status = libphoebe.interp(req, axes[0:3], table, status=True)
+            ld_coeffs = ld_coeffs[0]
         else:
             req = np.vstack((Teff, logg, abun)).T
-            ld_coeffs = libphoebe.interp(req, axes[0:3], table).T
+            ld_coeffs, status = libphoebe.interp(req, axes[0:3], table, status=True)
+            ld_coeffs = ld_coeffs.T
 
-        nanmask = np.isnan(np.sum(ld_coeffs, axis=0))
-        if not hasattr(nanmask, '__iter__'):
-            nanmask = np.array((nanmask,))
+        nanmask = status > 0
         if np.any(nanmask):
             raise ValueError('Atmosphere parameters out of bounds: ldatm=%s, teff=%s, logg=%s, abun=%s' % (ldatm, req[:,0][nanmask], req[:,1][nanmask], req[:,2][nanmask]))
 
@@ -1893,14 +1935,16 @@ class Passband:
 
             if not hasattr(Teff, '__iter__'):
                 req = np.array(((Teff, logg, abun, extinct, Rv),))
-                extinct_factor = libphoebe.interp(req, self._ck2004_extinct_axes[0:5], table)[0][0]
+                extinct_factor, status = libphoebe.interp(req, self._ck2004_extinct_axes[0:5], table, status=True)
+                extinct_factor = extinct_factor[0][0]
             else:
                 extinct=extinct*np.ones(len(Teff))
                 Rv=Rv*np.ones(len(Teff))
                 req = np.vstack((Teff, logg, abun, extinct, Rv)).T
-                extinct_factor = libphoebe.interp(req, self._ck2004_extinct_axes[0:5], table).T[0]
+                extinct_factor, status = libphoebe.interp(req, self._ck2004_extinct_axes[0:5], table, status=True)
+                extinct_factor = extinct_factor.T[0]
 
-            nanmask = np.isnan(extinct_factor)
+            nanmask = status > 0
             if np.any(nanmask):
                 raise ValueError('Atmosphere parameters out of bounds: atm=%s, extinct=%f, Rv=%f, Teff=%s, logg=%s, abun=%s' % (atm, extinct, Rv, Teff[nanmask], logg[nanmask], abun[nanmask]))
 
@@ -1917,14 +1961,16 @@ class Passband:
 
             if not hasattr(Teff, '__iter__'):
                 req = np.array(((Teff, logg, abun, extinct, Rv),))
-                extinct_factor = libphoebe.interp(req, self._phoenix_extinct_axes, table)[0][0]
+                extinct_factor, status = libphoebe.interp(req, self._phoenix_extinct_axes, table, status=True)
+                extinct_factor = extinct_factor[0][0]
             else:
                 extinct=extinct*np.ones_like(Teff)
                 Rv=Rv*np.ones_like(Teff)
                 req = np.vstack((Teff, logg, abun, extinct, Rv)).T
-                extinct_factor = libphoebe.interp(req, self._phoenix_extinct_axes, table).T[0]
+                extinct_factor, status = libphoebe.interp(req, self._phoenix_extinct_axes, table, status=True)
+                extinct_factor = extinct_factor.T[0]
 
-            nanmask = np.isnan(extinct_factor)
+            nanmask = status > 0
             if np.any(nanmask):
                 raise ValueError('Atmosphere parameters out of bounds: atm=%s, extinct=%f, Rv=%f, Teff=%s, logg=%s, abun=%s' % (atm, extinct, Rv, Teff[nanmask], logg[nanmask], abun[nanmask]))
 
@@ -1943,14 +1989,16 @@ class Passband:
 
             if not hasattr(Teff, '__iter__'):
                 req = np.array(((Teff, extinct, Rv),))
-                extinct_factor = libphoebe.interp(req, self._bb_extinct_axes[0:3], table)[0][0]
+                extinct_factor, status = libphoebe.interp(req, self._bb_extinct_axes[0:3], table, status=True)
+                extinct_factor = extinct_factor[0][0]
             else:
                 extinct=extinct*np.ones(len(Teff))
                 Rv=Rv*np.ones(len(Teff))
                 req = np.vstack((Teff, extinct, Rv)).T
-                extinct_factor = libphoebe.interp(req, self._bb_extinct_axes[0:3], table).T[0]
+                extinct_factor, status = libphoebe.interp(req, self._bb_extinct_axes[0:3], table, status=True)
+                extinct_factor = extinct_factor.T[0]
 
-            nanmask = np.isnan(extinct_factor)
+            nanmask = status > 0
             if np.any(nanmask):
                 raise ValueError('Atmosphere parameters out of bounds: atm=%s, extinct=%f, Rv=%f, Teff=%s, logg=%s, abun=%s' % (atm, extinct, Rv, Teff[nanmask], logg[nanmask], abun[nanmask]))
 
@@ -2061,36 +2109,27 @@ class Passband:
         return 10**Inorm
 
     def _log10_Imu_ck2004(self, Teff, logg, abun, mu, photon_weighted=False):
-        if not hasattr(Teff, '__iter__'):
-            req = np.array(((Teff, logg, abun, mu),))
-            log10_Imu = libphoebe.interp(req, self._ck2004_intensity_axes, self._ck2004_Imu_photon_grid if photon_weighted else self._ck2004_Imu_energy_grid)[0][0]
-        else:
-            req = np.vstack((Teff, logg, abun, mu)).T
-            log10_Imu = libphoebe.interp(req, self._ck2004_intensity_axes, self._ck2004_Imu_photon_grid if photon_weighted else self._ck2004_Imu_energy_grid).T[0]
+        log10_Imu = libphoebe.interp_imu(Teff, logg, abun, mu, self._ck2004_intensity_axes, self._ck2004_Imu_photon_grid if photon_weighted else self._ck2004_Imu_energy_grid)
 
+        if not hasattr(Teff, '__iter__'):
+            return log10_Imu[0]
         return log10_Imu
 
     def _Imu_ck2004(self, Teff, logg, abun, mu, photon_weighted=False):
-        if not hasattr(Teff, '__iter__'):
-            req = np.array(((Teff, logg, abun, mu),))
-            Imu = libphoebe.interp(req, self._ck2004_intensity_axes, self._ck2004_Imu_photon_grid if photon_weighted else self._ck2004_Imu_energy_grid)[0][0]
-        else:
-            req = np.vstack((Teff, logg, abun, mu)).T
-            Imu = libphoebe.interp(req, self._ck2004_intensity_axes, self._ck2004_Imu_photon_grid if photon_weighted else self._ck2004_Imu_energy_grid).T[0]
+        Imu = libphoebe.interp_imu(Teff, logg, abun, mu, self._ck2004_intensity_axes, self._ck2004_Imu_photon_grid if photon_weighted else self._ck2004_Imu_energy_grid, pow10=True)
 
-        return 10**Imu
+        if not hasattr(Teff, '__iter__'):
+            return Imu[0]
+        return Imu
 
     def _Imu_phoenix(self, Teff, logg, abun, mu, photon_weighted=False):
-        if not hasattr(Teff, '__iter__'):
-            req = np.array(((Teff, logg, abun, mu),))
-            Imu = libphoebe.interp(req, self._phoenix_intensity_axes, self._phoenix_Imu_photon_grid if photon_weighted else self._phoenix_Imu_energy_grid)[0][0]
-        else:
-            req = np.vstack((Teff, logg, abun, mu)).T
-            Imu = libphoebe.interp(req, self._phoenix_intensity_axes, self._phoenix_Imu_photon_grid if photon_weighted else self._phoenix_Imu_energy_grid).T[0]
+        Imu = libphoebe.interp_imu(Teff, logg, abun, mu, self._phoenix_intensity_axes, self._phoenix_Imu_photon_grid if photon_weighted else self._phoenix_Imu_energy_grid, pow10=True)
 
-        return 10**Imu
+        if not hasattr(Teff, '__iter__'):
+            return Imu[0]
+        return Imu
 
-    def Inorm(self, Teff=5772., logg=4.43, abun=0.0, atm='ck2004', ldatm='ck2004', ldint=None, ld_func='interp', ld_coeffs=None, photon_weighted=False):
+    def Inorm(self, Teff=5772., logg=4.43, abun=0.0, atm='ck2004', ldatm='ck2004', ldint=None, ld_func='interp', ld_coeffs=None, photon_weighted=False, cache_key=None):
         """
 
         Arguments
@@ -2115,6 +2154,8 @@ class Passband:
         * `ld_coeffs` (list, optional, default=None): limb darkening coefficients
             for the corresponding limb darkening function, `ld_func`.
         * `photon_weighted` (bool, optional, default=False): photon/energy switch
+        * `cache_key` (optional, default=None): key of the mesh under which
+            looked up limb darkening coefficients are cached.
 
         Returns
         ----------
@@ -2142,14 +2183,14 @@ class Passband:
             else:
                 retval = 10**self._log10_Inorm_bb_energy(Teff)
             if ldint is None:
-                ldint = self.ldint(Teff, logg, abun, ldatm, ld_func, ld_coeffs, photon_weighted)
+                ldint = self.ldint(Teff, logg, abun, ldatm, ld_func, ld_coeffs, photon_weighted, cache_key=cache_key)
             retval /= ldint
 
         elif atm == 'extern_planckint' and 'extern_planckint:Inorm' in self.content:
             # -1 below is for cgs -> SI:
             retval = 10**(self._log10_Inorm_extern_planckint(Teff)-1)
             if ldint is None:
-                ldint = self.ldint(Teff, logg, abun, ldatm, ld_func, ld_coeffs, photon_weighted)
+                ldint = self.ldint(Teff, logg, abun, ldatm, ld_func, ld_coeffs, photon_weighted, cache_key=cache_key)
             retval /= ldint
 
         elif atm == 'extern_atmx' and 'extern_atmx:Inorm' in self.content:
@@ -2170,7 +2211,7 @@ class Passband:
             raise ValueError('Atmosphere parameters out of bounds: atm=%s, ldatm=%s, Teff=%s, logg=%s, abun=%s' % (atm, ldatm, Teff[nanmask], logg[nanmask], abun[nanmask]))
         return retval
 
-    def Imu(self, Teff=5772., logg=4.43, abun=0.0, mu=1.0, atm='ck2004', ldatm='ck2004', ldint=None, ld_func='interp', ld_coeffs=None, photon_weighted=False):
+    def Imu(self, Teff=5772., logg=4.43, abun=0.0, mu=1.0, atm='ck2004', ldatm='ck2004', ldint=None, ld_func='interp', ld_coeffs=None, photon_weighted=False, cache_key=None):
         """
         Arguments
         ----------
@@ -2194,6 +2235,8 @@ class Passband:
         * `ld_coeffs` (list, optional, default=None): limb darkening coefficients
             for the corresponding limb darkening function, `ld_func`.
         * `photon_weighted` (bool, optional, default=False): photon/energy switch
+        * `cache_key` (optional, default=None): key of the mesh under which
+            looked up limb darkening coefficients are cached.
 
         Returns
         ----------
@@ -2232,6 +2275,16 @@ class Passband:
         if ld_coeffs is None:
             # LD function can be passed without coefficients; in that
             # case we need to interpolate them from the tables.
+            ld_lookup = self._ld_lookup(ldatm, ld_func, photon_weighted, cache_key)
+            if ld_lookup is not None:
+                ld, status = libphoebe.ld_lookup_D(ld_lookup, Teff, logg, abun, mu, status=True)
+                nanmask = status > 0
+                if np.any(nanmask):
+                    raise ValueError('Atmosphere parameters out of bounds: ldatm=%s, Teff=%s, logg=%s, abun=%s' % (ldatm, np.atleast_1d(Teff)[nanmask], np.atleast_1d(logg)[nanmask], np.atleast_1d(abun)[nanmask]))
+                if not hasattr(Teff, '__iter__'):
+                    ld = ld[0]
+                return self.Inorm(Teff=Teff, logg=logg, abun=abun, atm=atm, ldatm=ldatm, ldint=ldint, ld_func=ld_func, photon_weighted=photon_weighted, cache_key=cache_key) * ld
+
             ld_coeffs = self.interpolate_ldcoeffs(Teff, logg, abun, ldatm, ld_func, photon_weighted)
 
         if ld_func == 'linear':
@@ -2272,7 +2325,7 @@ class Passband:
 
         return ldint
 
-    def ldint(self, Teff=5772., logg=4.43, abun=0.0, ldatm='ck2004', ld_func='interp', ld_coeffs=None, photon_weighted=False):
+    def ldint(self, Teff=5772., logg=4.43, abun=0.0, ldatm='ck2004', ld_func='interp', ld_coeffs=None, photon_weighted=False, cache_key=None):
         """
         Arguments
         ----------
@@ -2285,6 +2338,8 @@ class Passband:
         * `ld_coeffs` (list, optional, default=None): limb darkening coefficients
             for the corresponding limb darkening function, `ld_func`.
         * `photon_weighted` (bool, optional, default=False): photon/energy switch
+        * `cache_key` (optional, default=None): key of the mesh under which
+            looked up limb darkening coefficients are cached.
 
         Returns
         ----------
@@ -2312,6 +2367,16 @@ class Passband:
             return retval
 
         if ld_coeffs is None:
+            ld_lookup = self._ld_lookup(ldatm, ld_func, photon_weighted, cache_key)
+            if ld_lookup is not None:
+                retval, status = libphoebe.ld_lookup_ldint(ld_lookup, Teff, logg, abun, status=True)
+                nanmask = status > 0
+                if np.any(nanmask):
+                    raise ValueError('Atmosphere parameters out of bounds: Teff=%s, logg=%s, abun=%s' % (np.atleast_1d(Teff)[nanmask], np.atleast_1d(logg)[nanmask], np.atleast_1d(abun)[nanmask]))
+                if not hasattr(Teff, '__iter__'):
+                    return retval[0]
+                return retval
+
             ld_coeffs = self.interpolate_ldcoeffs(Teff, logg, abun, ldatm, ld_func, photon_weighted)
 
         if ld_func == 'linear':
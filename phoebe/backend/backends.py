@@ -12,12 +12,12 @@ import itertools
 
 from phoebe.parameters import dataset as _dataset
 from phoebe.parameters import StringParameter, DictParameter, ArrayParameter, ParameterSet
-from phoebe.parameters.parameters import _extract_index_from_string
+from phoebe.parameters.parameters import _extract_index_from_string, FloatArrayParameter
 from phoebe import dynamics
-from phoebe.backend import universe, etvs, horizon_analytic
+from phoebe.backend import universe, etvs, horizon_analytic, scheduler
 from phoebe.atmospheres import passbands
 from phoebe.distortions  import roche
-from phoebe.frontend import io
+from phoebe.frontend import io, binary
 import phoebe.frontend.bundle
 from phoebe.dependencies.nparray.nparray import Array as _nparrayArray
 from phoebe import u, c
@@ -59,6 +59,21 @@ def _progressbar(args, total=None, show_progressbar=True):
     else:
         return args
 
+def _write_progress(out_fname, i, total, last_progress=None):
+    """
+    write the percentage of completed iterations to out_fname.progress so that
+    a detached job can report its progress (see JobParameter.attach).  The file
+    is only re-written when the integer percentage changes.  Returns the
+    written percentage.
+    """
+    progress = int(100 * i / total) if total else 100
+    if progress != last_progress and mpi.myrank == 0:
+        # write to a temporary file first so that the job never reads a partial file
+        with open(out_fname+'.progress.tmp', 'w') as f:
+            f.write('{}\n'.format(progress))
+        os.replace(out_fname+'.progress.tmp', out_fname+'.progress')
+    return progress
+
 from scipy.stats import norm as _norm
 
 
@@ -396,6 +411,180 @@ def _make_packet(qualifier, value, time, info, **kwargs):
 
     return packet
 
+def _bundle_snapshot(b):
+    """
+    binary snapshot (see phoebe.frontend.binary.dumps) of the parameters of
+    the bundle needed by the workers to compute a model.  Existing models,
+    solver options, solutions and figures are left out, and arrays are sent
+    as raw binary blocks instead of json lists.
+    """
+    return binary.dumps(b.exclude(context=['model', 'solver', 'solution', 'figure'], **_skip_filter_checks).to_json(keep_arrays=True))
+
+def _packetlists_to_columns(packetlists):
+    """
+    convert the packetlists returned by _run_chunk into one column per
+    dataset, component, kind, and qualifier holding the times and values of
+    all of its packets.  Scalar values are collected into a single float
+    array (in the unit of the first value), so that a worker sends a few
+    arrays back to the master instead of a dictionary per value.
+    """
+    columns = {}
+    for packetlist in packetlists:
+        for packet in packetlist:
+            key = (packet['dataset'], packet['component'], packet['kind'], packet['qualifier'])
+            if key not in columns.keys():
+                columns[key] = ([], [])
+            columns[key][0].append(packet['time'])
+            columns[key][1].append(packet['value'])
+
+    rcolumns = []
+    for (dataset, component, kind, qualifier), (times, values) in columns.items():
+        column = {'dataset': dataset, 'component': component, 'kind': kind,
+                  'qualifier': qualifier, 'times': times, 'values': values,
+                  'unit': None}
+
+        if None not in times:
+            column['times'] = np.asarray(times, dtype=float)
+
+        unit = getattr(values[0], 'unit', None)
+        if np.all([np.ndim(v)==0 and getattr(v, 'unit', None) == unit for v in values]):
+            array = np.empty(len(values), dtype=float)
+            try:
+                for i, v in enumerate(values):
+                    array[i] = v.to_value(unit) if unit is not None else v
+            except (TypeError, ValueError):
+                pass
+            else:
+                column['values'] = array
+                column['unit'] = unit.to_string() if unit is not None else None
+
+        rcolumns.append(column)
+
+    return rcolumns
+
+def _columns_to_packetlist(columns):
+    """
+    inverse of _packetlists_to_columns, returns a single packetlist with
+    one packet per value
+    """
+    packetlist = []
+    for column in columns:
+        unit = u.Unit(column['unit']) if column['unit'] is not None else None
+        for time, value in zip(column['times'], column['values']):
+            packetlist.append({'dataset': column['dataset'],
+                               'component': column['component'],
+                               'kind': column['kind'],
+                               'qualifier': column['qualifier'],
+                               'value': value*unit if unit is not None else value,
+                               'time': time})
+    return packetlist
+
+class _ColumnIngest(object):
+    """
+    bulk assignment of columns (see _packetlists_to_columns) to the synthetic
+    Parameters in new_syns.  The Parameters are indexed by their tags once.
+    Each FloatArrayParameter that is filled by time gets a single copy of its
+    array, into which the columns of all workers are written as slices before
+    being set back to the Parameter by flush.  Columns that cannot be
+    written into the array (see add) release it first, so that values set
+    per packet are never overwritten by flush.
+    """
+    def __init__(self, new_syns):
+        self._params = {}
+        for param in new_syns.to_list():
+            self._params[(param.dataset, param.component, param.kind, param.qualifier, param.time)] = param
+        self._arrays = {}
+
+    def _array_target(self, key):
+        """
+        (param, array, times, sorter of times) for the FloatArrayParameter
+        filled by time at key, or None if there is no such Parameter
+        """
+        if key not in self._arrays.keys():
+            target = None
+            param = self._params.get(key+(None,))
+            times_param = self._params.get(key[:3]+('times', None))
+            if isinstance(param, FloatArrayParameter) and times_param is not None:
+                times = np.asarray(times_param.get_value(), dtype=float)
+                array = np.array(param.get_value(), dtype=float)
+                # duplicate times are left to ParameterSet.set_value
+                if len(times) and array.shape == times.shape and len(np.unique(times)) == len(times):
+                    target = (param, array, times, np.argsort(times))
+            self._arrays[key] = target
+
+        return self._arrays[key]
+
+    def _release(self, key):
+        """
+        set the array at key (if any) back to its Parameter and stop
+        collecting into it
+        """
+        target = self._arrays.get(key)
+        if target is not None:
+            target[0].set_value(target[1], ignore_readonly=True)
+        self._arrays[key] = None
+
+    def add(self, column):
+        """
+        write the values of column into its array or per-time Parameters.
+        Returns False (without writing anything) if column cannot be
+        assigned in bulk.
+        """
+        times = column['times']
+        values = column['values']
+        key = (column['dataset'], column['component'], column['kind'], column['qualifier'])
+
+        if not isinstance(times, np.ndarray):
+            self._release(key)
+            return False
+
+        unit = u.Unit(column['unit']) if column['unit'] is not None else None
+
+        target = self._array_target(key)
+        if target is not None:
+            param, array, ptimes, sorter = target
+            if not isinstance(values, np.ndarray):
+                # values that were not collected into a single array by
+                # _packetlists_to_columns (ie. mixed units)
+                try:
+                    values = np.array([v.to_value(param.default_unit) if hasattr(v, 'to_value') else v for v in values], dtype=float)
+                except (TypeError, ValueError, u.UnitsError):
+                    self._release(key)
+                    return False
+                if values.shape != times.shape:
+                    self._release(key)
+                    return False
+
+            # nearest of the times on either side, matched within the same
+            # tolerance as filtering by time in ParameterSet.filter
+            pos = np.searchsorted(ptimes, times, sorter=sorter)
+            lo = sorter[np.maximum(pos-1, 0)]
+            hi = sorter[np.minimum(pos, len(ptimes)-1)]
+            inds = np.where(np.abs(ptimes[lo]-times) < np.abs(ptimes[hi]-times), lo, hi)
+            found = np.isclose(ptimes[inds], times, rtol=0, atol=1e-6)
+            if not np.all(found):
+                raise ValueError("times {} of {}@{}@{} not found in the synthetics".format(times[~found], column['qualifier'], column['component'], column['dataset']))
+            if unit is not None:
+                values = values * unit.to(param.default_unit)
+            array[inds] = values
+            return True
+
+        # per-time Parameters (ie. meshes)
+        params = [self._params.get(key+('{:09f}'.format(time),)) for time in times]
+        if None in params:
+            return False
+        for param, value in zip(params, values):
+            param.set_value(value*unit if unit is not None else value, ignore_readonly=True)
+        return True
+
+    def flush(self):
+        """
+        set the arrays back to their Parameters
+        """
+        for target in self._arrays.values():
+            if target is not None:
+                target[0].set_value(target[1], ignore_readonly=True)
+
 class BaseBackend(object):
     def __init__(self):
         return
@@ -432,7 +621,8 @@ class BaseBackend(object):
         to send to all workers.  The returned packet will be passed on as
         _run_chunk(**packet) with the following exceptions:
 
-        * b: the bundle will be included in the packet serialized
+        * b: the bundle will be included in the packet as a binary snapshot
+            (see _bundle_snapshot) if within MPI
         * compute: the label of the compute options will be included in the packet
         * backend: the class name will be passed on in the packet so the worker can call the correct backend
         * all kwargs will be passed on verbatim
@@ -449,7 +639,7 @@ class BaseBackend(object):
             if len(packet.get('infolists', packet.get('infolist', []))) > kwargs.get('max_computations'):
                 raise ValueError("more than {} computations detected ({} estimated).".format(kwargs.get('max_computations'), len(packet['infolists'])))
 
-        packet['b'] = b.to_json() if mpi.enabled else b
+        packet['b'] = _bundle_snapshot(b) if mpi.enabled else b
         packet['compute'] = compute
         packet['backend'] = self.__class__.__name__
 
@@ -466,31 +656,50 @@ class BaseBackend(object):
     def _fill_syns(self, new_syns, rpacketlists_per_worker):
         """
         rpacket_per_worker is a list of packetlists as returned by _run_chunk
+        or of columns as returned by _packetlists_to_columns
+
+        The results are assigned per column (see _ColumnIngest), falling back
+        on new_syns.set_value per packet for any column that cannot be
+        assigned in bulk.
         """
         # TODO: move to BaseBackendByDataset or BaseBackend?
         logger.debug("rank:{}/{} {}._fill_syns".format(mpi.myrank, mpi.nprocs, self.__class__.__name__))
 
+        ingest = _ColumnIngest(new_syns)
         for packetlists in rpacketlists_per_worker:
             # single worker
-            for packetlist in packetlists:
-                # single time/dataset
-                for packet in packetlist:
+            if len(packetlists) and isinstance(packetlists[0], dict):
+                # columns sent by a worker
+                columns = packetlists
+            else:
+                columns = _packetlists_to_columns(packetlists)
+
+            for column in columns:
+                if ingest.add(column):
+                    continue
+
+                for packet in _columns_to_packetlist([column]):
                     # single parameter
                     try:
                         new_syns.set_value(check_visible=False, check_default=False, ignore_readonly=True, **packet)
                     except Exception as err:
                         raise ValueError("failed to set value from packet: {}.  Original error: {}".format(packet, str(err)))
 
+        ingest.flush()
+
         return new_syns
 
     def _run_worker(self, packet):
         # the worker receives the bundle serialized, so we need to unpack it
         logger.debug("rank:{}/{} _run_worker".format(mpi.myrank, mpi.nprocs))
-        packet['b'] = phoebe.frontend.bundle.Bundle(packet['b'])
+        if isinstance(packet['b'], bytes):
+            packet['b'] = phoebe.frontend.bundle.Bundle(binary.loads(packet['b']))
+        else:
+            packet['b'] = phoebe.frontend.bundle.Bundle(packet['b'])
         # do the computations requested for this worker
         rpacketlists = self._run_chunk(**packet)
-        # send the results back to the master (root=0)
-        mpi.comm.gather(rpacketlists, root=0)
+        # send the results back to the master (root=0) as columns
+        mpi.comm.gather(_packetlists_to_columns(rpacketlists), root=0)
 
     def run(self, b, compute, dataset=None, times=[], **kwargs):
         """
@@ -554,29 +763,50 @@ class BaseBackendByTime(BaseBackend):
         return packet, new_syns
 
 
+    def _estimate_time_costs(self, b, infolists, **kwargs):
+        """
+        estimate the relative cost of computing each of the times (one per
+        entry in infolists), used to deal out the times across the MPI ranks
+        (see scheduler.plan).  kwargs are those returned by _worker_setup.
+
+        This can be subclassed by any backend in which the cost differs
+        between the times, by default the cost is the number of entries in
+        the infolist.
+        """
+        return np.array([len(infolist) for infolist in infolists], dtype=float)
+
     def _run_chunk(self, b, compute, times, infolists, **kwargs):
         logger.debug("rank:{}/{} _run_chunk".format(mpi.myrank, mpi.nprocs))
 
         worker_setup_kwargs = self._worker_setup(b, compute, times, infolists, **kwargs)
 
-        inds = range(len(times))
-
         if mpi.enabled:
-            # np.array_split(any_input_array, mpi.nprocs)[mpi.myrank]
-            inds = np.array_split(inds, mpi.nprocs)[mpi.myrank]
-            times = np.array_split(times, mpi.nprocs)[mpi.myrank]
-            infolists = np.array_split(infolists, mpi.nprocs)[mpi.myrank]
+            # the times are taken dynamically from the queues shared by all
+            # ranks (see scheduler), seeded by the estimated cost of each time
+            costs = self._estimate_time_costs(b, infolists, **worker_setup_kwargs) if mpi.myrank == 0 else None
+            inds = scheduler.TimeScheduler(costs, mpi.comm)
+        else:
+            inds = range(len(times))
+
+        out_fname = kwargs.get('out_fname', False) if not b._within_solver else False
+        progress = None
 
         packetlists = [] # entry per-time
-        for i, time, infolist in _progressbar(zip(inds, times, infolists), total=len(times), show_progressbar=not b._within_solver and kwargs.get('progressbar', False)):
+        for i in _progressbar(inds, total=len(times) if not mpi.enabled else None, show_progressbar=not b._within_solver and kwargs.get('progressbar', False)):
             if kwargs.get('out_fname', False) and os.path.isfile(kwargs.get('out_fname')+'.kill'):
                 logger.warning("received kill signal, exiting sampler loop")
                 break
 
-            packetlist = self._run_single_time(b, i, time, infolist, **worker_setup_kwargs)
+            packetlist = self._run_single_time(b, i, times[i], infolists[i], **worker_setup_kwargs)
             packetlists.append(packetlist)
 
-        logger.debug("rank:{}/{} _run_chunk returning packetlist".format(mpi.myrank, mpi.nprocs))
+            if out_fname:
+                progress = _write_progress(out_fname, inds.ntaken if mpi.enabled else len(packetlists), len(times), progress)
+
+        if mpi.enabled:
+            inds.free()
+
+        logger.debug("rank:{}/{} _run_chunk returning packetlist for {} times".format(mpi.myrank, mpi.nprocs, len(packetlists)))
         return packetlists
 
 
@@ -612,6 +842,9 @@ class BaseBackendByDataset(BaseBackend):
             # np.array_split(any_input_array, mpi.nprocs)[mpi.myrank]
             infolist = np.array_split(infolist, mpi.nprocs)[mpi.myrank]
 
+        out_fname = kwargs.get('out_fname', False) if not b._within_solver else False
+        progress = None
+
         packetlists = [] # entry per-dataset
         for info in _progressbar(infolist, total=len(infolist), show_progressbar=not b._within_solver and kwargs.get('progressbar', False)):
             if kwargs.get('out_fname', False) and os.path.isfile(kwargs.get('out_fname')+'.kill'):
@@ -620,6 +853,9 @@ class BaseBackendByDataset(BaseBackend):
             packetlist = self._run_single_dataset(b, info, **worker_setup_kwargs)
             packetlists.append(packetlist)
 
+            if out_fname:
+                progress = _write_progress(out_fname, len(packetlists), len(infolist), progress)
+
         return packetlists
 
 def _call_run_single_model(args):
@@ -1061,10 +1297,44 @@ class PhoebeBackend(BaseBackendByTime):
                     meshablerefs=meshablerefs,
                     starrefs=starrefs,
                     dynamics_method=dynamics_method,
+                    times=times,
                     ts=ts, xs=xs, ys=ys, zs=zs,
                     vxs=vxs, vys=vys, vzs=vzs,
                     ethetas=ethetas, elongans=elongans, eincls=eincls)
 
+    def _estimate_time_costs(self, b, infolists, **kwargs):
+        system = kwargs.get('system')
+        starrefs = kwargs.get('starrefs')
+        xs = kwargs.get('xs')
+        ys = kwargs.get('ys')
+
+        needs_mesh = np.array([np.any([info['needs_mesh'] for info in infolist]) for infolist in infolists])
+        ninfos = np.array([len(infolist) for infolist in infolists])
+
+        # relative cost of placing the meshes and populating the observables,
+        # increased if the meshes are rebuilt or irradiation is recomputed
+        # at every time
+        mesh_cost = 1.0
+        if np.any([body.needs_remesh for body in system.bodies]):
+            mesh_cost += 2.0
+        if system.irrad_method != 'none':
+            mesh_cost += 2.0
+
+        # eclipses only need to be handled at times when the projected
+        # separation of a pair of stars is small enough (see
+        # System.handle_eclipses, but with a conservative radius as the
+        # meshes are not available yet)
+        if len(system.bodies) == 1:
+            possible_eclipse = np.full(len(infolists), system.bodies[0].__class__.__name__ == 'Envelope')
+        else:
+            max_rs = [1.5*system.get_body(star).requiv for star in starrefs]
+            possible_eclipse = np.zeros(len(infolists), dtype=bool)
+            for i, j in itertools.combinations(range(len(starrefs)), 2):
+                proj_sep_sq = (np.asarray(xs[i])-np.asarray(xs[j]))**2 + (np.asarray(ys[i])-np.asarray(ys[j]))**2
+                possible_eclipse |= proj_sep_sq < (max_rs[i]+max_rs[j])**2
+
+        return 0.05*ninfos + needs_mesh*(mesh_cost + possible_eclipse)
+
     def _run_single_time(self, b, i, time, infolist, **kwargs):
         logger.debug("rank:{}/{} PhoebeBackend._run_single_time(i={}, time={}, infolist={}, **kwargs.keys={})".format(mpi.myrank, mpi.nprocs, i, time, infolist, kwargs.keys()))
 
@@ -1074,6 +1344,7 @@ class PhoebeBackend(BaseBackendByTime):
         meshablerefs = kwargs.get('meshablerefs')
         starrefs = kwargs.get('starrefs')
         dynamics_method = kwargs.get('dynamics_method')
+        times = kwargs.get('times')
         xs = kwargs.get('xs')
         ys = kwargs.get('ys')
         zs = kwargs.get('zs')
@@ -1112,6 +1383,13 @@ class PhoebeBackend(BaseBackendByTime):
             logger.debug("rank:{}/{} PhoebeBackend._run_single_time: calling system.update_positions at time={}".format(mpi.myrank, mpi.nprocs, time))
             system.update_positions(time, xi, yi, zi, vxi, vyi, vzi, ethetai, elongani, eincli, ds=di, Fs=Fi)
 
+            if i+1 < len(times) and not mpi.enabled:
+                # start meshing the next time-step in the background so that it
+                # overlaps with eclipses and observables at this time-step
+                # (with MPI, the cores are already used by the other processes)
+                xn, yn, zn, _, _, _, ethetan, elongann, eincln = dynamics.dynamics_at_i(xs, ys, zs, vxs, vys, vzs, ethetas, elongans, eincls, i=i+1)
+                system.prefetch_meshes(times[i+1], xn, yn, zn, ethetan, elongann, eincln)
+
             # Now we need to determine which triangles are visible and handle subdivision
             # NOTE: this should come after populate_observables so that each subdivided triangle
             # will have identical local quantities.  The only downside to this is that we can't
@@ -161,6 +161,9 @@ def native(meshes, xs, ys, zs, expose_horizon=False, horizon_method='boolean'):
     viewing_vector = np.array([0., 0., 1.])
 
 
+    # statistics of the horizon cuts are only available for the linear method
+    log_cut_stats = horizon_method=='linear' and logger.isEnabledFor(logging.DEBUG)
+
     # we need to send in ALL vertices but only the visible triangle information
     info = libphoebe.mesh_visibility(viewing_vector,
                                      vertices_flat,
@@ -169,7 +172,15 @@ def native(meshes, xs, ys, zs, expose_horizon=False, horizon_method='boolean'):
                                      tvisibilities=True,
                                      taweights=True,
                                      method=_bytes(horizon_method),
-                                     horizon=expose_horizon)
+                                     horizon=expose_horizon,
+                                     cut_stats=log_cut_stats)
+
+    if log_cut_stats:
+        # number of back-facing, forward-facing and triangles cut along the
+        # mu=0 horizon (to triangles and quadrilaterals), the latter depend on
+        # the resolution of the mesh at the horizon
+        cut_stats = info['cut_stats']
+        logger.debug("linear horizon: {} back-facing, {} forward-facing, {} cut ({} to triangles, {} to quadrilaterals) triangles".format(cut_stats[0], cut_stats[1], cut_stats[2]+cut_stats[3], cut_stats[2], cut_stats[3]))
 
     visibilities = meshes.unpack_column_flat(info['tvisibilities'], computed_type='triangles')
     weights = meshes.unpack_column_flat(info['taweights'], computed_type='triangles')
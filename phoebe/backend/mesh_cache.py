@@ -0,0 +1,215 @@
+"""
+Persistent on-disk cache of meshes built by the Bodies in universe.
+
+Each entry is a directory named by the hash of everything that determines
+the mesh (see key) and holds one .npy file per column returned by
+_build_mesh (along with the scale and the instantaneous mesh arguments it
+was built from).  Entries are memory-mapped (copy-on-write) when read back, so a
+warm start only touches the pages that are actually used.  When the cache
+grows beyond conf.mesh_cache_maxsize (in MB), the least recently used entries
+are removed until it is back under _evict_fraction of that size.  Scanning the
+cache directory is only needed once per process and then whenever the size
+tracked since the last scan exceeds the maximum, so that storing many entries
+does not list the whole cache every time.  The scan also removes temporary
+directories left behind by processes that crashed while storing an entry.
+
+The cache is disabled unless a directory is set, either through the
+PHOEBE_MESH_CACHE_DIR environment variable or phoebe.conf.mesh_cache_on(dir).
+Several processes (ie MPI workers) may safely share the same directory.
+"""
+
+import os
+import json
+import time
+import shutil
+import hashlib
+import tempfile
+import numpy as np
+
+from phoebe import conf, __version__
+
+import logging
+logger = logging.getLogger("MESH_CACHE")
+logger.addHandler(logging.NullHandler())
+
+# bump whenever the meshes built by the Bodies in universe (or the meshing
+# in libphoebe) change, so that existing entries are no longer used
+MESH_VERSION = 1
+
+_scale_fname = '_scale.npy'
+_mesh_args_prefix = '_mesh_args_'
+
+_evict_fraction = 0.9
+# temporary directories (see put) older than this (in seconds) are assumed to
+# be left behind by a crashed process and removed when scanning
+_tmp_timeout = 3600
+# size (in bytes) of the cache in each directory as of the last scan, plus
+# all entries stored by this process since
+_tracked_size = {}
+
+def _jsonable(value):
+    if isinstance(value, np.ndarray):
+        return value.tolist()
+    if isinstance(value, np.generic):
+        return value.item()
+    if isinstance(value, (tuple, list)):
+        return [_jsonable(v) for v in value]
+    return value
+
+def key(*args):
+    """
+    hash of the arguments (floats, strings, arrays, or nested lists of those),
+    to be used as the key for get and put.  The phoebe version and
+    MESH_VERSION are included so that entries are not reused across changes in
+    the meshing code.
+    """
+    s = json.dumps([__version__, MESH_VERSION] + _jsonable(list(args)))
+    return hashlib.sha1(s.encode('utf-8')).hexdigest()
+
+def get(key):
+    """
+    access the (new_mesh_dict, scale, mesh_args) stored under key, or None if
+    there is no such entry (or the cache is disabled).
+    """
+    cache_dir = conf.mesh_cache_dir
+    if cache_dir is None:
+        return None
+
+    entry = os.path.join(cache_dir, key)
+    if not os.path.isdir(entry):
+        return None
+
+    try:
+        new_mesh = {}
+        scale = None
+        mesh_args = {}
+        for fname in os.listdir(entry):
+            value = np.load(os.path.join(entry, fname), mmap_mode='c')
+            if value.ndim == 0:
+                value = value.item()
+            if fname == _scale_fname:
+                scale = value
+            elif fname.startswith(_mesh_args_prefix):
+                mesh_args[int(fname[len(_mesh_args_prefix):-4])] = value
+            else:
+                new_mesh[fname[:-4]] = value
+    except (IOError, OSError, ValueError) as err:
+        # ie. removed by another process while reading
+        logger.warning("could not read mesh cache entry {}: {}".format(key, err))
+        return None
+
+    # access time is not reliable on all filesystems, so we touch the entry
+    # to keep track of the least recently used entries
+    try:
+        os.utime(entry, None)
+    except OSError:
+        pass
+
+    logger.debug("mesh cache hit {}".format(key))
+    return new_mesh, scale, tuple([mesh_args[i] for i in range(len(mesh_args))])
+
+def put(key, new_mesh, scale, mesh_args=()):
+    """
+    store the output of _build_mesh under key (nothing is done if the cache is
+    disabled or the mesh contains anything other than arrays and numbers).
+    """
+    cache_dir = conf.mesh_cache_dir
+    if cache_dir is None:
+        return
+
+    if not all([isinstance(v, (np.ndarray, float, int, np.generic)) for v in new_mesh.values()]):
+        logger.debug("mesh cannot be cached, skipping {}".format(key))
+        return
+
+    entry = os.path.join(cache_dir, key)
+    if os.path.isdir(entry):
+        return
+
+    if not os.path.isdir(cache_dir):
+        os.makedirs(cache_dir, exist_ok=True)
+
+    # write into a temporary directory which is then renamed, so that other
+    # processes never see a partial entry
+    tmp_entry = tempfile.mkdtemp(prefix='.tmp_', dir=cache_dir)
+    try:
+        for k, v in new_mesh.items():
+            np.save(os.path.join(tmp_entry, k+'.npy'), np.asarray(v))
+        np.save(os.path.join(tmp_entry, _scale_fname), np.asarray(scale))
+        for i, v in enumerate(mesh_args):
+            np.save(os.path.join(tmp_entry, '{}{}.npy'.format(_mesh_args_prefix, i)), np.asarray(v))
+        entry_size = _entry_size(tmp_entry)
+        os.rename(tmp_entry, entry)
+    except OSError:
+        # most likely another process stored the same entry in the meantime
+        shutil.rmtree(tmp_entry, ignore_errors=True)
+        return
+
+    logger.debug("mesh cache stored {}".format(key))
+
+    maxsize = conf.mesh_cache_maxsize*1024**2
+    size = _tracked_size.get(cache_dir, None)
+    if size is None or size + entry_size > maxsize:
+        # entries stored or evicted by other processes are only seen when
+        # scanning, so the tracked size is refreshed here
+        _tracked_size[cache_dir] = _evict(cache_dir, maxsize)
+    else:
+        _tracked_size[cache_dir] = size + entry_size
+
+def _entry_size(entry):
+    return sum([os.path.getsize(os.path.join(entry, f)) for f in os.listdir(entry)])
+
+def _evict(cache_dir, maxsize):
+    """
+    if the cache exceeds maxsize (in bytes), remove the least recently used
+    entries until it fits in _evict_fraction*maxsize.  Temporary directories
+    older than _tmp_timeout are removed as well.  Returns the size of the
+    remaining entries.
+    """
+    now = time.time()
+    entries = []
+    for fname in os.listdir(cache_dir):
+        entry = os.path.join(cache_dir, fname)
+        if not os.path.isdir(entry):
+            continue
+        if fname.startswith('.tmp_'):
+            try:
+                stale = now - os.path.getmtime(entry) > _tmp_timeout
+            except OSError:
+                continue
+            if stale:
+                logger.debug("mesh cache removing stale {}".format(fname))
+                shutil.rmtree(entry, ignore_errors=True)
+            continue
+        if fname.startswith('.'):
+            continue
+        try:
+            entries.append((os.path.getmtime(entry), _entry_size(entry), entry))
+        except OSError:
+            continue
+
+    size = sum([e[1] for e in entries])
+    if size <= maxsize:
+        return size
+
+    for mtime, entry_size, entry in sorted(entries):
+        if size <= _evict_fraction*maxsize:
+            break
+        logger.debug("mesh cache evicting {}".format(os.path.basename(entry)))
+        shutil.rmtree(entry, ignore_errors=True)
+        size -= entry_size
+
+    return size
+
+def clear():
+    """
+    remove all entries from the cache directory
+    """
+    cache_dir = conf.mesh_cache_dir
+    if cache_dir is None or not os.path.isdir(cache_dir):
+        return
+
+    _tracked_size.pop(cache_dir, None)
+    for fname in os.listdir(cache_dir):
+        entry = os.path.join(cache_dir, fname)
+        if os.path.isdir(entry):
+            shutil.rmtree(entry, ignore_errors=True)
@@ -93,163 +93,31 @@ def project_onto_potential(r, pot_name, *args):
 
 def discretize_wd_style(N, q, F, d, Phi):
     """
-    TODO: add documentation
-
-    New implementation. I'll make this work first, then document.
+    Discretize the primary Roche lobe in the style of Wilson-Devinney.
+
+    The lobe is divided into N rings in colatitude per quadrant, each ring
+    into elements of constant longitude step.  The center of each element
+    is projected onto the equipotential and the element is represented by
+    two triangles in the tangential plane at the center.  The grid is
+    computed in libphoebe (see roche_wd_mesh) for the first octant and
+    reflected over the y- and z-directions.
+
+    :parameter int N: number of rings in colatitude per quadrant
+    :parameter float q: mass-ratio
+    :parameter float F: syncpar
+    :parameter float d: instantaneous unitless separation
+    :parameter float Phi: potential
+    :return: the table of triangles with 19 columns: center (3), half of the
+        WD area of the element, vertices (9), normal (3), theta, phi and the
+        area of the triangle (see mesh.wd_grid_to_mesh_dict)
     """
 
-    DEBUG = False
+    info = libphoebe.roche_wd_mesh(q, F, d, Phi, N)
 
-    Ts = []
+    if info['nfailed']:
+        logger.warning('projection did not converge for {} elements'.format(info['nfailed']))
 
-    potential = 'BinaryRoche'
-    r0 = libphoebe.roche_pole(q, F, d, Phi)
-
-    # The following is a hack that needs to go!
-    pot_name = potential
-    dpdx = globals()['d%sdx'%(pot_name)]
-    dpdy = globals()['d%sdy'%(pot_name)]
-    dpdz = globals()['d%sdz'%(pot_name)]
-
-    if DEBUG:
-        import matplotlib.pyplot as plt
-        from matplotlib.path import Path
-        import matplotlib.patches as patches
-
-        fig = plt.figure()
-        ax1 = fig.add_subplot(131)
-        ax2 = fig.add_subplot(132)
-        ax3 = fig.add_subplot(133)
-        ax1.set_xlim(-0.3, 0.3) # -1.6 1.6
-        ax1.set_ylim(-0.3, 0.3)
-        ax2.set_xlim(-0.3, 0.3)
-        ax2.set_ylim(-0.3, 0.3)
-        ax3.set_xlim(-0.3, 0.3)
-        ax3.set_ylim(-0.3, 0.3)
-        ax1.set_xlabel('x')
-        ax1.set_ylabel('y')
-        ax2.set_xlabel('x')
-        ax2.set_ylabel('z')
-        ax3.set_xlabel('y')
-        ax3.set_ylabel('z')
-
-    # Rectangle centers:
-    theta = np.array([np.pi/2*(k-0.5)/N for k in range(1, N+2)])
-    phi = np.array([[np.pi*(l-0.5)/Mk for l in range(1, Mk+1)] for Mk in np.array(1 + 1.3*N*np.sin(theta), dtype=int)])
-
-    for t in range(len(theta)-1):
-        dtheta = theta[t+1]-theta[t]
-        for i in range(len(phi[t])):
-            dphi = phi[t][1]-phi[t][0]
-
-            # Project the vertex onto the potential; this will be our center point:
-            rc = np.array((r0*sin(theta[t])*cos(phi[t][i]), r0*sin(theta[t])*sin(phi[t][i]), r0*cos(theta[t])))
-            vc = project_onto_potential(rc, potential, d, q, F, Phi).r
-
-            # Next we need to find the tangential plane, which we'll get by finding the normal,
-            # which is the negative of the gradient:
-            nc = np.array((-dpdx(vc, d, q, F), -dpdy(vc, d, q, F), -dpdz(vc, d, q, F)))
-
-            # Then we need to find the intercontext of +/-dtheta/dphi-deflected
-            # radius vectors with the tangential plane. We do that by solving
-            #
-            #   d = [(p0 - l0) \dot n] / (l \dot n),
-            #
-            # where p0 and l0 are reference points on the plane and on the line,
-            # respectively, n is the normal vector, and l is the line direction
-            # vector. For convenience l0 can be set to 0, and p0 is just vc. d
-            # then measures the distance from the origin along l.
-
-            l1 = np.array((sin(theta[t]-dtheta/2)*cos(phi[t][i]-dphi/2), sin(theta[t]-dtheta/2)*sin(phi[t][i]-dphi/2), cos(theta[t]-dtheta/2)))
-            l2 = np.array((sin(theta[t]-dtheta/2)*cos(phi[t][i]+dphi/2), sin(theta[t]-dtheta/2)*sin(phi[t][i]+dphi/2), cos(theta[t]-dtheta/2)))
-            l3 = np.array((sin(theta[t]+dtheta/2)*cos(phi[t][i]+dphi/2), sin(theta[t]+dtheta/2)*sin(phi[t][i]+dphi/2), cos(theta[t]+dtheta/2)))
-            l4 = np.array((sin(theta[t]+dtheta/2)*cos(phi[t][i]-dphi/2), sin(theta[t]+dtheta/2)*sin(phi[t][i]-dphi/2), cos(theta[t]+dtheta/2)))
-
-            r1 = np.dot(vc, nc) / np.dot(l1, nc) * l1
-            r2 = np.dot(vc, nc) / np.dot(l2, nc) * l2
-            r3 = np.dot(vc, nc) / np.dot(l3, nc) * l3
-            r4 = np.dot(vc, nc) / np.dot(l4, nc) * l4
-
-            # This sorts out the vertices, now we need to fudge the surface
-            # area. WD does not take curvature of the equipotential at vc
-            # into account, so the surface area computed from these vertex-
-            # delimited surfaces will generally be different from what WD
-            # computes. Thus, we compute the surface area the same way WD
-            # does it and assign it to each element even though that isn't
-            # quite its area:
-            #
-            #   dsigma = || r^2 sin(theta)/cos(gamma) dtheta dphi ||,
-            #
-            # where gamma is the angle between l and n.
-
-            cosgamma = np.dot(vc, nc)/np.sqrt(np.dot(vc, vc))/np.sqrt(np.dot(nc, nc))
-            dsigma = np.abs(np.dot(vc, vc)*np.sin(theta[t])/cosgamma*dtheta*dphi)
-
-            # Temporary addition: triangle areas: ######################
-            side1 = sqrt((r1[0]-r2[0])**2 + (r1[1]-r2[1])**2 + (r1[2]-r2[2])**2)
-            side2 = sqrt((r1[0]-r3[0])**2 + (r1[1]-r3[1])**2 + (r1[2]-r3[2])**2)
-            side3 = sqrt((r2[0]-r3[0])**2 + (r2[1]-r3[1])**2 + (r2[2]-r3[2])**2)
-            s = 0.5*(side1 + side2 + side3)
-
-            dsigma_t_sq = s*(s-side1)*(s-side2)*(s-side3)
-            dsigma_t = sqrt(dsigma_t_sq) if dsigma_t_sq > 0 else 0.0
-            ############################################################
-
-            if DEBUG:
-                fc = 'orange'
-
-                verts = [(r1[0], r1[1]), (r2[0], r2[1]), (r3[0], r3[1]), (r4[0], r4[1]), (r1[0], r1[1])]
-                codes = [Path.MOVETO, Path.LINETO, Path.LINETO, Path.LINETO, Path.CLOSEPOLY]
-                path = Path(verts, codes)
-                patch = patches.PathPatch(path, facecolor=fc, lw=2)
-                ax1.add_patch(patch)
-
-                verts = [(r1[0], r1[2]), (r2[0], r2[2]), (r3[0], r3[2]), (r4[0], r4[2]), (r1[0], r1[2])]
-                codes = [Path.MOVETO, Path.LINETO, Path.LINETO, Path.LINETO, Path.CLOSEPOLY]
-                path = Path(verts, codes)
-                patch = patches.PathPatch(path, facecolor=fc, lw=2)
-                ax2.add_patch(patch)
-
-                verts = [(r1[1], r1[2]), (r2[1], r2[2]), (r3[1], r3[2]), (r4[1], r4[2]), (r1[1], r1[2])]
-                codes = [Path.MOVETO, Path.LINETO, Path.LINETO, Path.LINETO, Path.CLOSEPOLY]
-                path = Path(verts, codes)
-                patch = patches.PathPatch(path, facecolor=fc, lw=2)
-                ax3.add_patch(patch)
-
-            # Ts.append(np.array((vc[0], vc[1], vc[2], dsigma/2, r1[0], r1[1], r1[2], r2[0], r2[1], r2[2], r3[0], r3[1], r3[2], nc[0], nc[1], nc[2])))
-            # Ts.append(np.array((vc[0], vc[1], vc[2], dsigma/2, r3[0], r3[1], r3[2], r4[0], r4[1], r4[2], r1[0], r1[1], r1[2], nc[0], nc[1], nc[2])))
-
-            # # Instead of recomputing all quantities, just reflect over the y- and z-directions.
-            # Ts.append(np.array((vc[0], -vc[1],  vc[2], dsigma/2, r1[0], -r1[1],  r1[2], r2[0], -r2[1],  r2[2], r3[0], -r3[1],  r3[2], nc[0], -nc[1], nc[2])))
-            # Ts.append(np.array((vc[0], -vc[1],  vc[2], dsigma/2, r3[0], -r3[1],  r3[2], r4[0], -r4[1],  r4[2], r1[0], -r1[1],  r1[2], nc[0], -nc[1], nc[2])))
-
-            # Ts.append(np.array((vc[0],  vc[1], -vc[2], dsigma/2, r1[0],  r1[1], -r1[2], r2[0],  r2[1], -r2[2], r3[0],  r3[1], -r3[2], nc[0],  nc[1], -nc[2])))
-            # Ts.append(np.array((vc[0],  vc[1], -vc[2], dsigma/2, r3[0],  r3[1], -r3[2], r4[0],  r4[1], -r4[2], r1[0],  r1[1], -r1[2], nc[0],  nc[1], -nc[2])))
-
-            # Ts.append(np.array((vc[0], -vc[1], -vc[2], dsigma/2, r1[0], -r1[1], -r1[2], r2[0], -r2[1], -r2[2], r3[0], -r3[1], -r3[2], nc[0], -nc[1], -nc[2])))
-            # Ts.append(np.array((vc[0], -vc[1], -vc[2], dsigma/2, r3[0], -r3[1], -r3[2], r4[0], -r4[1], -r4[2], r1[0], -r1[1], -r1[2], nc[0], -nc[1], -nc[2])))
-
-            # FOR TESTING - report theta/phi for each triangle
-            # uncomment the above original version eventually
-            Ts.append(np.array((vc[0], vc[1], vc[2], dsigma/2, r1[0], r1[1], r1[2], r2[0], r2[1], r2[2], r3[0], r3[1], r3[2], nc[0], nc[1], nc[2], theta[t], phi[t][0], dsigma_t)))
-            Ts.append(np.array((vc[0], vc[1], vc[2], dsigma/2, r3[0], r3[1], r3[2], r4[0], r4[1], r4[2], r1[0], r1[1], r1[2], nc[0], nc[1], nc[2], theta[t], phi[t][0], dsigma_t)))
-
-            # Instead of recomputing all quantities, just reflect over the y- and z-directions.
-            Ts.append(np.array((vc[0], -vc[1],  vc[2], dsigma/2, r1[0], -r1[1],  r1[2], r2[0], -r2[1],  r2[2], r3[0], -r3[1],  r3[2], nc[0], -nc[1], nc[2], theta[t], -phi[t][0], dsigma_t)))
-            Ts.append(np.array((vc[0], -vc[1],  vc[2], dsigma/2, r3[0], -r3[1],  r3[2], r4[0], -r4[1],  r4[2], r1[0], -r1[1],  r1[2], nc[0], -nc[1], nc[2], theta[t], -phi[t][0], dsigma_t)))
-
-            Ts.append(np.array((vc[0],  vc[1], -vc[2], dsigma/2, r1[0],  r1[1], -r1[2], r2[0],  r2[1], -r2[2], r3[0],  r3[1], -r3[2], nc[0],  nc[1], -nc[2], np.pi-theta[t], phi[t][0], dsigma_t)))
-            Ts.append(np.array((vc[0],  vc[1], -vc[2], dsigma/2, r3[0],  r3[1], -r3[2], r4[0],  r4[1], -r4[2], r1[0],  r1[1], -r1[2], nc[0],  nc[1], -nc[2], np.pi-theta[t], phi[t][0], dsigma_t)))
-
-            Ts.append(np.array((vc[0], -vc[1], -vc[2], dsigma/2, r1[0], -r1[1], -r1[2], r2[0], -r2[1], -r2[2], r3[0], -r3[1], -r3[2], nc[0], -nc[1], -nc[2], np.pi-theta[t], -phi[t][0], dsigma_t)))
-            Ts.append(np.array((vc[0], -vc[1], -vc[2], dsigma/2, r3[0], -r3[1], -r3[2], r4[0], -r4[1], -r4[2], r1[0], -r1[1], -r1[2], nc[0], -nc[1], -nc[2], np.pi-theta[t], -phi[t][0], dsigma_t)))
-
-    if DEBUG:
-        plt.show()
-
-    # Assemble a mesh table:
-    table = np.array(Ts)
-    return table
+    return info['table']
 
 def discretize_wd_style_oc(N, q, F, d, Phi,recompute_neck=True):
 
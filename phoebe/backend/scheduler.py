@@ -0,0 +1,136 @@
+"""
+Dynamic scheduling of times across MPI ranks for the backends that compute
+by time (see BaseBackendByTime._run_chunk).
+
+The times are split into small chunks of consecutive times.  The chunks are
+dealt out to one queue per rank, largest estimated cost first (see
+BaseBackendByTime._estimate_time_costs), so that all ranks start with about
+the same estimated amount of work.  Each rank then takes chunks from the front
+of its own queue and, once that is empty, steals chunks from the back of the
+queue with the most estimated work left.  A wrong estimate for one rank
+therefore does not hold up all the others.
+
+The queues are stored as [head, tail) pairs of indices into the chunks in an
+MPI window on rank 0, which are only accessed while holding an exclusive
+lock, so that no rank ever has to actively respond to any other rank.
+"""
+
+import heapq
+import numpy as np
+
+import logging
+logger = logging.getLogger("SCHEDULER")
+logger.addHandler(logging.NullHandler())
+
+# number of chunks per rank: more chunks give finer balancing but more
+# locking of the queues
+CHUNKS_PER_PROC = 8
+
+def plan(costs, nprocs, chunks_per_proc=CHUNKS_PER_PROC):
+    """
+    split the indices of costs into chunks of consecutive indices and deal
+    the chunks out to nprocs queues (longest processing time first).
+
+    Returns the chunks (in the order of the queues, each queue ordered by
+    decreasing cost), the cost of each chunk and the [head, tail) indices of
+    each queue into the chunks.
+    """
+    costs = np.asarray(costs, dtype=float)
+    nchunks = min(len(costs), chunks_per_proc*nprocs)
+    if nchunks == 0:
+        return [], np.zeros(0), np.zeros((nprocs, 2), dtype=int)
+
+    chunks = np.array_split(np.arange(len(costs)), nchunks)
+    chunk_costs = np.array([costs[chunk].sum() for chunk in chunks])
+
+    loads = [(0.0, rank) for rank in range(nprocs)]
+    queues = [[] for rank in range(nprocs)]
+    for k in np.argsort(-chunk_costs, kind='stable'):
+        load, rank = heapq.heappop(loads)
+        queues[rank].append(k)
+        heapq.heappush(loads, (load+chunk_costs[k], rank))
+
+    order = [k for queue in queues for k in queue]
+    lengths = np.array([len(queue) for queue in queues])
+    bounds = np.column_stack((np.cumsum(lengths)-lengths, np.cumsum(lengths)))
+
+    return [chunks[k] for k in order], chunk_costs[order], bounds
+
+class TimeScheduler(object):
+    """
+    iterate over the indices of the times to be computed by this rank.  Must
+    be created by all ranks of comm at the same time, with the costs from
+    rank 0 being used by all of them, and freed by all of them (see free)
+    once they are done iterating.
+    """
+    def __init__(self, costs, comm):
+        from mpi4py import MPI
+        self._MPI = MPI
+        self._comm = comm
+        self.myrank = comm.Get_rank()
+        self.nprocs = comm.Get_size()
+
+        self.chunks, chunk_costs, bounds = comm.bcast(plan(costs, self.nprocs) if self.myrank == 0 else None, root=0)
+        self._cumcosts = np.concatenate(([0.0], np.cumsum(chunk_costs)))
+
+        # [head, tail) of each queue followed by the number of times taken
+        # from all queues
+        self._buf = np.zeros(2*self.nprocs+1, dtype=np.int64)
+        if self.myrank == 0:
+            self._state = np.append(bounds.flatten(), 0).astype(np.int64)
+            self._win = MPI.Win.Create(self._state, comm=comm)
+        else:
+            self._win = MPI.Win.Create(None, comm=comm)
+
+        self.ntaken = 0
+        self.nstolen = 0
+
+    def _take(self):
+        """
+        pop the next chunk from the front of our own queue or steal one from
+        the back of the queue with the most estimated work left.  Returns the
+        index of the chunk or None if all queues are empty.
+        """
+        self._win.Lock(0, self._MPI.LOCK_EXCLUSIVE)
+        try:
+            self._win.Get(self._buf, 0)
+            self._win.Flush(0)
+
+            queues = self._buf[:-1].reshape(-1, 2)
+            k = None
+            if queues[self.myrank, 0] < queues[self.myrank, 1]:
+                k = queues[self.myrank, 0]
+                queues[self.myrank, 0] += 1
+            else:
+                remaining = self._cumcosts[queues[:,1]] - self._cumcosts[queues[:,0]]
+                remaining[queues[:,0] >= queues[:,1]] = -1
+                victim = np.argmax(remaining)
+                if remaining[victim] >= 0:
+                    queues[victim, 1] -= 1
+                    k = queues[victim, 1]
+                    self.nstolen += 1
+
+            if k is not None:
+                self._buf[-1] += len(self.chunks[k])
+                self._win.Put(self._buf, 0)
+
+            self.ntaken = self._buf[-1]
+        finally:
+            self._win.Unlock(0)
+
+        return k
+
+    def __iter__(self):
+        while True:
+            k = self._take()
+            if k is None:
+                return
+            for i in self.chunks[k]:
+                yield i
+
+    def free(self):
+        """
+        free the MPI window (collective, all ranks must call free)
+        """
+        logger.debug("rank:{}/{} stole {} chunks".format(self.myrank, self.nprocs, self.nstolen))
+        self._win.Free()
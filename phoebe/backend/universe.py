@@ -4,10 +4,11 @@ from scipy.special import sph_harm as Y
 from math import sqrt, sin, cos, acos, atan2, trunc, pi
 import sys, os
 import copy
+from concurrent.futures import ThreadPoolExecutor
 
 from phoebe.atmospheres import passbands
 from phoebe.distortions import roche, rotstar
-from phoebe.backend import eclipse, oc_geometry, mesh, mesh_wd
+from phoebe.backend import eclipse, oc_geometry, mesh, mesh_wd, mesh_cache
 from phoebe.utils import _bytes
 import libphoebe
 
@@ -87,6 +88,21 @@ def _value(obj):
         return [_value(o) for o in obj]
     return obj
 
+# single background thread used by System.prefetch_meshes to build the meshes
+# of the next time-step while the current one is still being processed.
+_mesh_executor = None
+
+def _get_mesh_executor():
+    """
+    returns None if there is no spare core, in which case the two threads
+    would only compete for the GIL
+    """
+    global _mesh_executor
+    if _mesh_executor is None:
+        ncpus = len(os.sched_getaffinity(0)) if hasattr(os, 'sched_getaffinity') else os.cpu_count()
+        _mesh_executor = ThreadPoolExecutor(max_workers=1) if ncpus and ncpus > 1 else False
+    return _mesh_executor or None
+
 def _estimate_delta(ntriangles, area):
     """
     estimate the value for delta to send to marching based on the number of
@@ -114,6 +130,9 @@ class System(object):
 
         self.is_first_refl_iteration = True
 
+        # component: (time, future) of meshes being built ahead of time
+        self._prefetched_meshes = {}
+
         for body in self._bodies.values():
             body.system = self
             body.dynamics_method = dynamics_method
@@ -296,9 +315,45 @@ class System(object):
         self.zs = np.array(_value(zs))
 
         for starref,body in self.items():
+            # a prefetched mesh for any other time is simply discarded
+            prefetched_time, prefetched_mesh = self._prefetched_meshes.pop(starref, (None, None))
+            if prefetched_time != time:
+                prefetched_mesh = None
+
             body.update_position(time, xs, ys, zs, vxs, vys, vzs,
                                  ethetas, elongans, eincls,
-                                 ds=ds, Fs=Fs, ignore_effects=ignore_effects)
+                                 ds=ds, Fs=Fs, ignore_effects=ignore_effects,
+                                 prefetched_mesh=prefetched_mesh)
+
+    def prefetch_meshes(self, time, xs, ys, zs, ethetas, elongans, eincls):
+        """
+        Start building the meshes needed by the next call to
+        update_positions (at `time`) in a background thread.
+
+        Only bodies that remesh at every time-step are prefetched.  The
+        marching itself releases the GIL, so this overlaps with handling
+        eclipses and populating observables at the current time.  The meshes
+        are picked up, in order, by update_positions.
+
+        all arrays should be for `time`, but iterable over all bodies
+        """
+        executor = _get_mesh_executor()
+        if executor is None:
+            return
+
+        system = copy.copy(self)
+        system.xs = np.array(_value(xs))
+        system.ys = np.array(_value(ys))
+        system.zs = np.array(_value(zs))
+
+        for starref,body in self.items():
+            if not isinstance(body, Star) or body.mesh_method != 'marching' or not body.needs_remesh:
+                continue
+
+            logger.debug("{}: prefetching mesh for t={}".format(starref, time))
+            future = executor.submit(body._build_mesh_at, system, time,
+                                     ethetas, elongans, eincls)
+            self._prefetched_meshes[starref] = (time, future)
 
 
     def populate_observables(self, time, kinds, datasets, ignore_effects=False):
@@ -894,12 +949,59 @@ class Body(object):
         # return new_mesh_dict, scale
         raise NotImplementedError("_build_mesh must be overridden by the subclass of Body")
 
+    def _build_mesh_at(self, system, time, ethetas, elongans, eincls):
+        """
+        build the mesh needed at a later time (see System.prefetch_meshes).
+        This works on a shallow copy so that the state used by the current
+        time-step is left untouched.
+        """
+        body = copy.copy(self)
+        body.system = system
+        body.inst_vals = {}
+        body.reset_time(time, ethetas[self.ind_self], elongans[self.ind_self], eincls[self.ind_self])
+
+        return body._build_mesh_cached(mesh_method=self.mesh_method)
+
+    def _build_mesh_cached(self, mesh_method):
+        """
+        _build_mesh, but going through the on-disk mesh cache if enabled
+        (see phoebe.conf.mesh_cache_on)
+        """
+        if conf.mesh_cache_dir is None:
+            return self._build_mesh(mesh_method=mesh_method)
+
+        key = mesh_cache.key(self.__class__.__name__, mesh_method,
+                             self._mesh_cache_inputs,
+                             getattr(self, 'sma', None),
+                             getattr(self, 'ntriangles', None), getattr(self, 'gridsize', None),
+                             self.mesh_init_phi)
+
+        cached = mesh_cache.get(key)
+        if cached is not None:
+            new_mesh_dict, scale, mesh_args = cached
+            self.inst_vals['mesh_args'] = mesh_args
+            return new_mesh_dict, scale
+
+        new_mesh_dict, scale = self._build_mesh(mesh_method=mesh_method)
+        mesh_cache.put(key, new_mesh_dict, scale, self.instantaneous_mesh_args)
+        return new_mesh_dict, scale
+
+    @property
+    def _mesh_cache_inputs(self):
+        """
+        everything that determines instantaneous_mesh_args, used to look up the
+        mesh cache.  Subclasses for which computing instantaneous_mesh_args is
+        expensive should override this with their inputs instead.
+        """
+        return self.instantaneous_mesh_args
+
     def update_position(self, time,
                         xs, ys, zs, vxs, vys, vzs,
                         ethetas, elongans, eincls,
                         ds=None, Fs=None,
                         ignore_effects=False,
                         component_com_x=None,
+                        prefetched_mesh=None,
                         **kwargs):
         """
         Update the position of the star into its orbit
@@ -916,6 +1018,8 @@ class Body(object):
         :parameter list eincls: a list/array of euler-incls of ALL COMPONENTS in the :class:`System`
         :parameter list ds: (optional) a list/array of instantaneous distances of ALL COMPONENTS in the :class:`System`
         :parameter list Fs: (optional) a list/array of instantaneous syncpars of ALL COMPONENTS in the :class:`System`
+        :parameter prefetched_mesh: (optional) future returning the output of
+            _build_mesh at this time (see :meth:`System.prefetch_meshes`)
         """
         logger.debug("{}.update_position ignore_effects={}".format(self.component, ignore_effects))
         self.reset_time(time, ethetas[self.ind_self], elongans[self.ind_self], eincls[self.ind_self])
@@ -939,7 +1043,10 @@ class Body(object):
             # d = _value(ds[self.ind_self])
             # F = _value(Fs[self.ind_self])
 
-            new_mesh_dict, scale = self._build_mesh(mesh_method=self.mesh_method)
+            if prefetched_mesh is not None:
+                new_mesh_dict, scale = prefetched_mesh.result()
+            else:
+                new_mesh_dict, scale = self._build_mesh_cached(mesh_method=self.mesh_method)
             if self.mesh_method != 'wd':
                 new_mesh_dict = self._offset_mesh(new_mesh_dict)
 
@@ -947,6 +1054,12 @@ class Body(object):
                 # quantities which, for a marching mesh, is at the vertices.
                 new_mesh_dict['normgrads'] = new_mesh_dict.pop('vnormgrads', np.array([]))
 
+                # marching meshes are reordered along a space-filling curve
+                # for memory locality, the permutations themselves are not
+                # needed by the mesh
+                new_mesh_dict.pop('vperm', None)
+                new_mesh_dict.pop('tperm', None)
+
             # And lastly, let's fill the velocities column - with zeros
             # at each of the vertices
             new_mesh_dict['velocities'] = np.zeros(new_mesh_dict['vertices'].shape if self.mesh_method != 'wd' else new_mesh_dict['centers'].shape)
@@ -1814,7 +1927,8 @@ class Star(Body):
                                  ldatm=ldatm,
                                  ld_func=ld_func if ld_mode != 'interp' else ld_mode,
                                  ld_coeffs=ld_coeffs,
-                                 photon_weighted=intens_weighting=='photon')
+                                 photon_weighted=intens_weighting=='photon',
+                                 cache_key=self.component)
             except ValueError as err:
                 if str(err).split(":")[0] == 'Atmosphere parameters out of bounds':
                     # let's override with a more helpful error message
@@ -1862,7 +1976,8 @@ class Star(Body):
                                      ldint=ldint,
                                      ld_func=ld_func if ld_mode != 'interp' else ld_mode,
                                      ld_coeffs=ld_coeffs,
-                                     photon_weighted=intens_weighting=='photon')
+                                     photon_weighted=intens_weighting=='photon',
+                                     cache_key=self.component)
 
 
             # Beaming/boosting
@@ -2018,6 +2133,16 @@ class Star_roche(Star):
         # instantaneous_gpole
         return getattr(libphoebe, 'roche_misaligned_gradOmega_only')
 
+    @property
+    def _mesh_cache_inputs(self):
+        """
+        the inputs of instantaneous_mesh_args (q, F, d, polar direction and
+        target volume) rather than the args themselves: solving for the
+        potential at the target volume dominates the cost of meshing, so it
+        is skipped entirely on a cache hit.
+        """
+        return self.q, self.F, self.instantaneous_d, self.polar_direction_xyz, self.get_target_volume(scaled=False)
+
     @property
     def instantaneous_mesh_args(self):
         logger.debug("{}.instantaneous_mesh_args".format(self.component))
@@ -2105,6 +2230,7 @@ class Star_roche(Star):
                                                                     cnormgrads=False,
                                                                     areas=True,
                                                                     volume=False,
+                                                                    reorder=True,
                                                                     init_phi=kwargs.get('mesh_init_phi', self.mesh_init_phi))
             except Exception as err:
                 if str(err) == 'There are too many triangles!':
@@ -2312,6 +2438,7 @@ class Star_roche_envelope_half(Star):
                                                          cnormgrads=False,
                                                          areas=True,
                                                          volume=False,
+                                                         reorder=True,
                                                          init_phi=kwargs.get('mesh_init_phi', self.mesh_init_phi))
             except Exception as err:
                 if str(err) == 'There are too many triangles!':
@@ -2497,6 +2624,7 @@ class Star_rotstar(Star):
                                                                       cnormgrads=False,
                                                                       areas=True,
                                                                       volume=True,
+                                                                      reorder=True,
                                                                       init_phi=kwargs.get('mesh_init_phi', self.mesh_init_phi))
             except Exception as err:
                 if str(err) == 'There are too many triangles!':
@@ -2664,6 +2792,7 @@ class Star_sphere(Star):
                                                           cnormgrads=False,
                                                           areas=True,
                                                           volume=True,
+                                                          reorder=True,
                                                           init_phi=kwargs.get('mesh_init_phi', self.mesh_init_phi))
             except Exception as err:
                 if str(err) == 'There are too many triangles!':
@@ -2871,73 +3000,42 @@ class Envelope(Body):
             logger.debug("split_mesh libphoebe.roche_contact_neck_min(q={}, d={}, pot={})".format(q, 1., pot))
             nekmin = libphoebe.roche_contact_neck_min(np.pi / 2., q, 1., pot)['xmin']
 
-            # initialize the subcomp array
-            subcomp = np.zeros(len(mesh['triangles']))
-            # default value is 0 for primary, need to set 1 for secondary
-            subcomp[mesh['centers'][:, 0] > nekmin] = 1
-
-            # will need to catch all vertices that are on the wrong side of the center
-            # get x coordinates of vertices per triangle, subtract nekmin to evaluate the side they're on
-            xs_vert_triang = mesh['vertices'][:, 0][mesh['triangles']] - nekmin
-            # assign 0 for primary and 1 for secondary
-            xs_vert_triang[xs_vert_triang < 0] = 0
-            xs_vert_triang[xs_vert_triang > 0] = 1
-
-            env_comp_verts = np.zeros(len(mesh['vertices']))
-            env_comp_triangles = np.zeros(len(mesh['triangles']))
-
-            env_comp_verts[mesh['vertices'][:,0] > nekmin] = 1
-            env_comp_triangles[mesh['centers'][:,0] > nekmin] = 1
-
-            # summing comp values per triangle flags those with mismatching vertex and triangle comps
-
-            vert_comp_triang = np.sum(xs_vert_triang, axis=1)
-            # vert_comp_triang = 0/3 - all on primary/secondary
-            # vert_comp_triang = 1 - two vertices on primary, one on secondary
-            # vert_comp_triang = 2 - one vertex on primary, two on secondary
-
-            # find indices of triangles with boundary crossing vertices
-
-            triangind_primsec = np.argwhere(((vert_comp_triang == 1) | (vert_comp_triang == 2)) & (subcomp == 0)).flatten()
-            triangind_secprim = np.argwhere(((vert_comp_triang == 1) | (vert_comp_triang == 2)) & (subcomp == 1)).flatten()
-
-            # to get the indices of the vertices that need to be copied because they cross from prim to sec:
-            vertind_primsec = mesh['triangles'][triangind_primsec][xs_vert_triang[triangind_primsec] == 1]
-            # and sec to prim:
-            vertind_secprim = mesh['triangles'][triangind_secprim][xs_vert_triang[triangind_secprim] == 0]
-
-            # combine the two in an array for convenient stacking of copied vertices
-            vinds_tocopy = np.hstack((vertind_primsec,vertind_secprim))
-
-            # this one can be merged into less steps
-            # vertices_primcopy = np.vstack((mesh['vertices'], mesh['vertices'][vertind_primsec]))
-            # vertices_seccopy = np.vstack((vertices_primcopy, mesh['vertices'][vertind_secprim]))
-            new_triangle_indices_prim = range(len(mesh['vertices']), len(mesh['vertices'])+len(vertind_primsec))
-            new_triangle_indices_sec = range(len(mesh['vertices'])+len(vertind_primsec), len(mesh['vertices'])+len(vertind_primsec)+len(vertind_secprim))
+            # side of the neck of each vertex (0 for primary, 1 for secondary),
+            # along with the fractional areas of the triangles crossing the neck
+            split = libphoebe.mesh_split_by_plane(mesh['vertices'], mesh['triangles'], nekmin)
+            env_comp_verts = split['vcomp']
+            # triangles are assigned by their centers
+            env_comp_triangles = (mesh['centers'][:,0] > nekmin).astype(int)
+            logger.debug("split_mesh: {} triangles crossing the neck".format(split['ncrossing']))
+
+            # vertices of triangles crossing the neck that are on the other
+            # side than the triangle itself need to be copied to that side
+            env_comp_verts_triang = env_comp_verts[mesh['triangles']]
+            crossing = np.any(env_comp_verts_triang != env_comp_verts_triang[:,:1], axis=1)
+            tocopy = (env_comp_verts_triang != env_comp_triangles[:,None]) & crossing[:,None]
+
+            # copies for the triangles of the primary first, then of the secondary
+            triangind = [np.argwhere(crossing & (env_comp_triangles == comp)).flatten() for comp in [0, 1]]
+            vinds_tocopy = np.hstack([mesh['triangles'][inds][tocopy[inds]] for inds in triangind])
+            new_vinds = len(mesh['vertices']) + np.arange(len(vinds_tocopy))
 
             mesh['vertices'] = np.vstack((mesh['vertices'], mesh['vertices'][vinds_tocopy]))
             mesh['pvertices'] = np.vstack((mesh['pvertices'], mesh['pvertices'][vinds_tocopy]))
             mesh['vnormals'] = np.vstack((mesh['vnormals'], mesh['vnormals'][vinds_tocopy]))
             mesh['normgrads'] = np.hstack((mesh['normgrads'].vertices, mesh['normgrads'].vertices[vinds_tocopy]))
             mesh['velocities'] = np.vstack((mesh['velocities'].vertices, np.zeros((len(vinds_tocopy),3))))
-            env_comp_verts = np.hstack((env_comp_verts, env_comp_verts[vinds_tocopy]))
-
-            # change the env_comp value of the copied vertices (hopefully right?)
-            env_comp_verts[new_triangle_indices_prim] = 0
-            env_comp_verts[new_triangle_indices_sec] = 1
-
-            # the indices of the vertices in the triangles array (crossing condition) need to be replaced with the new ones
-            # a bit of array reshaping magic, but it works
-            triangind_primsec_f = mesh['triangles'][triangind_primsec].flatten().copy()
-            triangind_secprim_f = mesh['triangles'][triangind_secprim].flatten().copy()
-            indices_prim = np.where(np.in1d(triangind_primsec_f, vertind_primsec))[0]
-            indices_sec = np.where(np.in1d(triangind_secprim_f, vertind_secprim))[0]
-
-            triangind_primsec_f[indices_prim] = new_triangle_indices_prim
-            triangind_secprim_f[indices_sec] = new_triangle_indices_sec
-
-            mesh['triangles'][triangind_primsec] = triangind_primsec_f.reshape(len(triangind_primsec_f) // 3, 3)
-            mesh['triangles'][triangind_secprim] = triangind_secprim_f.reshape(len(triangind_secprim_f) // 3, 3)
+            env_comp_verts = np.hstack((env_comp_verts, np.zeros(len(vinds_tocopy), dtype=int)))
+
+            # the copied vertices replace the originals in the triangles of
+            # their side and take over the side of those triangles
+            offset = 0
+            for comp, inds in enumerate(triangind):
+                triangles = mesh['triangles'][inds]
+                ncopies = np.count_nonzero(tocopy[inds])
+                triangles[tocopy[inds]] = new_vinds[offset:offset+ncopies]
+                mesh['triangles'][inds] = triangles
+                env_comp_verts[new_vinds[offset:offset+ncopies]] = comp
+                offset += ncopies
 
             # NOTE: this doesn't update the stored entries for scalars (volume, area, etc)
             mesh_halves = [mesh.take(env_comp_triangles==0, env_comp_verts==0), mesh.take(env_comp_triangles==1, env_comp_verts==1)]
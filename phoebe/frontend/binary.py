@@ -0,0 +1,192 @@
+"""
+Binary container format for bundles and ParameterSets.
+
+The file starts with a small fixed-size header (the magic string followed by
+the offset and size of the index), followed by the payloads of all numerical
+arrays as raw binary blocks (each aligned to BLOCK_ALIGN bytes), and finally
+the index itself: the json representation of the parameters (see
+ParameterSet.to_json) in which each array value is replaced by a reference to
+its block.
+
+When loading, the whole file is memory-mapped (copy-on-write) and each array
+is returned as a view into that map, so opening a file only parses the index
+and the payload of an array is only read from disk once it is accessed.
+
+The same format is used in memory (see dumps and loads) to send a snapshot of
+a bundle to the MPI workers, in which case the arrays are views into the
+received buffer.
+"""
+
+import io
+import os
+import contextlib
+import json
+import struct
+import tempfile
+import numpy as np
+
+from phoebe.utils import parse_json
+
+import logging
+logger = logging.getLogger("BINARY")
+logger.addHandler(logging.NullHandler())
+
+MAGIC = b'PHOEBEB1'
+BLOCK_ALIGN = 64
+
+_header = struct.Struct('<8sQQ')
+_block_key = '__phoebe_block__'
+
+def is_binary(filename):
+    """
+    whether filename points to a file in the binary format (as opposed to
+    json).
+    """
+    if not isinstance(filename, str):
+        return False
+    filename = os.path.expanduser(filename)
+    if not os.path.isfile(filename):
+        return False
+    with open(filename, 'rb') as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+def _is_block(value):
+    return isinstance(value, np.ndarray) and value.dtype.kind in 'biuf' and value.size > 0
+
+def _json_default(value):
+    # arrays nested within other values (ie dictionaries) are kept in the index
+    if isinstance(value, np.ndarray):
+        return value.tolist()
+    if isinstance(value, np.generic):
+        return value.item()
+    raise TypeError("could not serialize {} to json".format(type(value)))
+
+def _write(f, data):
+    """
+    write the header, blocks and index for data to the (seekable) file
+    object f.  Returns the number of binary blocks.
+    """
+    f.write(_header.pack(MAGIC, 0, 0))
+    blocks = []
+    index = []
+    for entry in data:
+        value = entry.get('value', None)
+        if _is_block(value):
+            value = np.ascontiguousarray(value)
+            offset = -f.tell() % BLOCK_ALIGN
+            f.write(b'\0' * offset)
+            blocks.append([f.tell(), value.dtype.str, list(value.shape)])
+            f.write(value.data)
+            entry = dict(entry)
+            entry['value'] = {_block_key: len(blocks)-1}
+        elif isinstance(value, np.ndarray):
+            entry = dict(entry)
+            entry['value'] = value.tolist()
+        index.append(entry)
+
+    index_offset = f.tell()
+    index = json.dumps({'params': index, 'blocks': blocks}, separators=(',', ':'), default=_json_default).encode('utf-8')
+    f.write(index)
+    f.seek(0)
+    f.write(_header.pack(MAGIC, index_offset, len(index)))
+    return len(blocks)
+
+@contextlib.contextmanager
+def replace_file(filename, mode='wb'):
+    """
+    open a temporary file (next to filename) for writing, which replaces
+    filename once closed without errors.  Any file that may still be
+    memory-mapped (see load) must be overwritten this way, since truncating
+    it would invalidate the arrays that are still to be written from it.
+    """
+    filename = os.path.expanduser(filename)
+    fd, tmp_filename = tempfile.mkstemp(prefix='.tmp_', dir=os.path.dirname(os.path.abspath(filename)))
+    # mkstemp only gives access to the owner, use the same permissions as open()
+    umask = os.umask(0)
+    os.umask(umask)
+    os.chmod(tmp_filename, 0o666 & ~umask)
+    try:
+        with os.fdopen(fd, mode) as f:
+            yield f
+        os.replace(tmp_filename, filename)
+    except:
+        if os.path.exists(tmp_filename):
+            os.remove(tmp_filename)
+        raise
+
+def dump(data, filename):
+    """
+    write data (a list of parameter dictionaries, where values may be numpy
+    arrays) to filename.  Numerical arrays are stored as binary blocks and
+    everything else in the json index.
+
+    The file is written to a temporary file which is then renamed (see
+    replace_file), so that overwriting a file that is currently memory-mapped
+    is safe.
+    """
+    filename = os.path.expanduser(filename)
+    with replace_file(filename) as f:
+        nblocks = _write(f, data)
+
+    logger.debug("saved {} parameters with {} binary blocks to {}".format(len(data), nblocks, filename))
+    return filename
+
+def dumps(data):
+    """
+    same as dump, but returns the binary representation as bytes instead of
+    writing to a file (ie. to be sent to the MPI workers, see
+    phoebe.backend.backends.BaseBackend.get_packet_and_syns).
+    """
+    f = io.BytesIO()
+    _write(f, data)
+    return f.getvalue()
+
+def load(filename):
+    """
+    read the list of parameter dictionaries from filename.  Values that were
+    stored as binary blocks are returned as (copy-on-write) np.memmap views
+    into the file.
+    """
+    filename = os.path.expanduser(filename)
+    with open(filename, 'rb') as f:
+        magic, index_offset, index_size = _header.unpack(f.read(_header.size))
+        if magic != MAGIC:
+            raise IOError("{} is not a binary PHOEBE file".format(filename))
+        f.seek(index_offset)
+        index = json.loads(f.read(index_size).decode('utf-8'), object_pairs_hook=parse_json)
+
+    blocks = index['blocks']
+    if len(blocks):
+        mm = np.memmap(filename, dtype=np.uint8, mode='c', shape=(index_offset,))
+
+    data = index['params']
+    for entry in data:
+        value = entry.get('value', None)
+        if isinstance(value, dict) and _block_key in value.keys():
+            offset, dtype, shape = blocks[value[_block_key]]
+            dtype = np.dtype(dtype)
+            nbytes = int(np.prod(shape)) * dtype.itemsize
+            entry['value'] = mm[offset:offset+nbytes].view(dtype).reshape(shape)
+
+    return data
+
+def loads(buf):
+    """
+    read the list of parameter dictionaries from the bytes returned by dumps.
+    Values that were stored as binary blocks are returned as (read-only)
+    views into buf, without copying.
+    """
+    magic, index_offset, index_size = _header.unpack_from(buf, 0)
+    if magic != MAGIC:
+        raise IOError("not a binary PHOEBE snapshot")
+    index = json.loads(bytes(buf[index_offset:index_offset+index_size]).decode('utf-8'), object_pairs_hook=parse_json)
+
+    data = index['params']
+    for entry in data:
+        value = entry.get('value', None)
+        if isinstance(value, dict) and _block_key in value.keys():
+            offset, dtype, shape = index['blocks'][value[_block_key]]
+            dtype = np.dtype(dtype)
+            entry['value'] = np.frombuffer(buf, dtype=dtype, count=int(np.prod(shape)), offset=offset).reshape(shape)
+
+    return data
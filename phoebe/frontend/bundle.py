@@ -10,6 +10,8 @@ except ImportError:
 
 import re
 import json
+import hashlib
+import shutil
 import atexit
 import time
 from datetime import datetime
@@ -41,6 +43,7 @@ from phoebe.backend import universe as _universe
 from phoebe.solverbackends import solverbackends as _solverbackends
 from phoebe.distortions import roche
 from phoebe.frontend import io
+from phoebe.frontend import binary
 from phoebe.atmospheres.passbands import list_installed_passbands, list_online_passbands, get_passband, update_passband, _timestamp_to_dt
 from phoebe import pool as _pool
 from phoebe.dependencies import distl as _distl
@@ -63,6 +66,16 @@ _bundle_cache_dir = os.path.abspath(os.path.join(os.path.dirname(os.path.abspath
 
 _skip_filter_checks = {'check_default': False, 'check_visible': False}
 
+# qualifiers that only enter the post-processing in run_compute (distance and
+# l3 flux-scaling, dataset-scaling, gaussian processes) and therefore do not
+# invalidate the raw results of the backend.  Only add qualifiers here that
+# are never read by the backends (ie. rv_offset is applied within the phoebe
+# backend for flux-weighted rvs).
+_postprocessing_qualifiers = ['distance', 'l3', 'l3_frac', 'l3_mode',
+                              'comments', 'gp_exclude_phases_enabled', 'gp_exclude_phases']
+# observations are only used by dataset-scaling and gaussian processes
+_postprocessing_dataset_qualifiers = ['fluxes', 'rvs', 'sigmas']
+
 # Attempt imports for client requirements
 try:
     """
@@ -485,6 +498,9 @@ class Bundle(ParameterSet):
 
         self._within_solver = False
 
+        # raw backend results per compute, see Bundle._get_backend_stage_key
+        self._backend_stage_cache = {}
+
         super(Bundle, self).__init__(params=params)
 
 
@@ -548,7 +564,8 @@ class Bundle(ParameterSet):
 
         Open a new bundle.
 
-        Open a bundle from a JSON-formatted PHOEBE 2 file.
+        Open a bundle from a JSON-formatted (or binary, see
+        <phoebe.frontend.bundle.Bundle.save>) PHOEBE 2 file.
         This is a constructor so should be called as:
 
         ```py
@@ -594,7 +611,10 @@ class Bundle(ParameterSet):
         def _ps_dict(ps, include_constrained=True):
             return {p.qualifier: p.get_quantity() if hasattr(p, 'get_quantity') else p.get_value() for p in ps.to_list() if (include_constrained or not p.is_constraint)}
 
-        if io._is_file(filename):
+        if binary.is_binary(filename):
+            logger.debug("importing from binary {}".format(filename))
+            filename = binary.load(filename)
+        elif io._is_file(filename):
             f = filename
         elif isinstance(filename, str):
             filename = os.path.expanduser(filename)
@@ -1333,7 +1353,7 @@ class Bundle(ParameterSet):
 
         return b
 
-    def save(self, filename, compact=False, incl_uniqueid=True):
+    def save(self, filename, compact=False, incl_uniqueid=True, binary=False):
         """
         Save the bundle to a JSON-formatted ASCII file.  This will run failed
         and delayed constraints and raise an error if they fail.
@@ -1347,6 +1367,11 @@ class Bundle(ParameterSet):
         * `filename` (string): relative or full path to the file
         * `compact` (bool, optional, default=False): whether to use compact
             file-formatting (may be quicker to save/load, but not as easily readable)
+        * `binary` (bool, optional, default=False): whether to save to a binary
+            file with the arrays (ie. models and meshes) stored as raw binary
+            blocks which are memory-mapped when opening the file with
+            <phoebe.frontend.bundle.Bundle.open>.  See
+            <phoebe.parameters.ParameterSet.save>.
 
         Returns
         -------------
@@ -1359,7 +1384,7 @@ class Bundle(ParameterSet):
         self.run_delayed_constraints()
         self.run_failed_constraints()
         return super(Bundle, self).save(filename, incl_uniqueid=incl_uniqueid,
-                                        compact=compact)
+                                        compact=compact, binary=binary)
 
     def export_legacy(self, filename, compute=None, skip_checks=False):
         """
@@ -7798,17 +7823,44 @@ class Bundle(ParameterSet):
         * (list): list of changed <phoebe.parameters.Parameter> objects.
 
         """
+        # the constraints are run in topological order (each after all the
+        # constraints that determine any of its variables), so that every
+        # constraint is only evaluated once, even if running an earlier one
+        # delays it again.  The expressions themselves are compiled and cached
+        # by the ConstraintParameter (see ConstraintParameter.get_result).
+        depths = {}
+
+        def _depth(constraint_id, visiting=()):
+            if constraint_id in depths:
+                return depths[constraint_id]
+            if constraint_id in visiting:
+                # cyclic constraints, fallback on the order they were delayed
+                return 0
+            constraint_param = self.get_parameter(uniqueid=constraint_id, context='constraint', **_skip_filter_checks)
+            depth = 0
+            for var in constraint_param._vars + constraint_param._addl_vars:
+                upstream_id = var.get_parameter()._is_constraint
+                if upstream_id is not None and upstream_id != constraint_id:
+                    depth = max(depth, _depth(upstream_id, visiting+(constraint_id,))+1)
+            depths[constraint_id] = depth
+            return depth
+
         changes = []
         delayed_constraints = self._delayed_constraints
         self._delayed_constraints = []
-        for constraint_id in delayed_constraints:
+        while len(delayed_constraints):
+            constraint_id = min(delayed_constraints, key=_depth)
+            delayed_constraints.remove(constraint_id)
             param = self.run_constraint(uniqueid=constraint_id, return_parameter=True, skip_kwargs_checks=True)
             if param not in changes:
                 changes.append(param)
-        if len(self._delayed_constraints):
-            # some of the calls above may have delayed even more constraints,
-            # we must keep calling recursively until they're all cleared
-            changes += self.run_delayed_constraints()
+
+            # running the constraint may have delayed even more constraints,
+            # which are all downstream and so can be added to this same pass
+            for constraint_id in self._delayed_constraints:
+                if constraint_id not in delayed_constraints:
+                    delayed_constraints.append(constraint_id)
+            self._delayed_constraints = []
 
         return changes
 
@@ -11173,6 +11225,35 @@ class Bundle(ParameterSet):
 
         return self.filter(compute=new_compute)
 
+    def _get_backend_stage_key(self, compute, dataset, times, kwargs):
+        """
+        Hash of all parameters (and run_compute arguments) that the raw
+        results of the backend depend on.  Parameters in
+        _postprocessing_qualifiers (and observations) only affect the
+        post-processing in run_compute, so the backend results cached under
+        this key in self._backend_stage_cache can be reused when only those
+        change and only the post-processing is re-run.
+        """
+        ps = self.exclude(context=['model', 'figure', 'solver', 'solution'], **_skip_filter_checks)
+        ps = ps.exclude(qualifier=_postprocessing_qualifiers, **_skip_filter_checks)
+        ps = ps.exclude(kind=['gp_sklearn', 'gp_celerite2'], context='feature', **_skip_filter_checks)
+        ps = ps.exclude(qualifier=_postprocessing_dataset_qualifiers, context='dataset', **_skip_filter_checks)
+        # raw values are hashed instead of to_json which is too slow to call
+        # on every run_compute
+        params_values = []
+        for p in ps.to_list():
+            value = getattr(p, '_value', None)
+            unit = str(getattr(value, 'unit', ''))
+            value = getattr(value, 'value', value)
+            if hasattr(value, 'tolist'):
+                value = value.tolist()
+            params_values.append([p.qualifier, p.component, p.dataset, p.feature,
+                                p.compute, p.context, p.kind, value, unit,
+                                str(getattr(p, '_default_unit', ''))])
+        kwargs = {k: v for k, v in kwargs.items() if k not in ['system', 'pblums_scale', 'pblums', 'progressbar', 'out_fname', 'in_export_script', 'jobid', 'model', 'overwrite', 'return_changes', 'comments', 'max_computations', 'skip_checks']}
+        key = json.dumps([compute, dataset, times, params_values, kwargs], sort_keys=True, default=str)
+        return hashlib.sha1(key.encode('utf-8')).hexdigest()
+
     def _prepare_compute(self, compute, model, dataset, from_export=False, **kwargs):
         """
         """
@@ -11903,37 +11984,72 @@ class Bundle(ParameterSet):
 
                 # we need to check both for enabled but also passed via dataset kwarg
                 ds_kinds_enabled = self.filter(dataset=dataset_this_compute, context='dataset', **_skip_filter_checks).kinds
-                if 'lc' in ds_kinds_enabled or 'rv' in ds_kinds_enabled or 'lp' in ds_kinds_enabled:
-                    logger.info("run_compute: computing necessary ld_coeffs, pblums, l3s")
-                    self.compute_ld_coeffs(compute=compute, skip_checks=True, set_value=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
-                    # NOTE that if pblum_method != 'phoebe', then system will be None
-                    # otherwise the system will be create which we can pass on to the backend
-                    # the phoebe backend can then skip initializing the system at least on the master proc
-                    # (workers will need to recreate the mesh)
-                    system, pblums_abs, pblums_scale, pblums_rel, pbfluxes = self.compute_pblums(compute=compute, ret_structured_dicts=True, skip_checks=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
-                    l3s = self.compute_l3s(compute=compute, use_pbfluxes=pbfluxes, ret_structured_dicts=True, skip_checks=True, skip_compute_ld_coeffs=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
+
+                # the raw results of the phoebe backend (meshes, eclipses,
+                # fluxes) are kept for re-use if only parameters entering the
+                # post-processing below change (l3, distance, dataset-scaling, etc)
+                if computeparams.kind == 'phoebe' and not self._within_solver and not mpi.within_mpirun:
+                    backend_stage_key = self._get_backend_stage_key(compute, dataset_this_compute, times, kwargs)
                 else:
-                    system = None
-                    pblums_scale = {}
-                    pblums_rel = {}
-                    l3s = {}
-
-                logger.info("run_compute: calling {} backend to create '{}' model".format(computeparams.kind, model))
-                if mpi.within_mpirun:
-                    logger.info("run_compute: within mpirun with nprocs={}".format(mpi.nprocs))
-                compute_class = getattr(backends, '{}Backend'.format(computeparams.kind.title()))
-                if computeparams.kind == 'phoebe':
-                    kwargs['system'] = system
-                    kwargs['pblums_scale'] = pblums_scale
-                elif computeparams.kind in ['legacy', 'jktebop', 'ellc']:
-                    # legacy uses pblums directly
-                    # jktebop, ellc use pblums for sbratio if decoupled, otherwise will ignore and use teffs
-                    kwargs['pblums'] = pblums_rel
-
-                ml_params = compute_class().run(self, computeparams.compute,
-                                                dataset=dataset_this_compute,
-                                                times=times,
-                                                **kwargs)
+                    backend_stage_key = None
+                backend_stage = self._backend_stage_cache.get(compute, None)
+
+                if backend_stage is not None and backend_stage[0] == backend_stage_key:
+                    logger.info("run_compute: re-using {} backend results, only post-processing parameters changed".format(computeparams.kind))
+                    _, ml_params, pblums_abs, pbfluxes = backend_stage
+                    ml_params = ml_params.copy()
+                    # pbfluxes are cached at unit distance
+                    distance = self.get_value(qualifier='distance', context='system', unit=u.m, **_skip_filter_checks)
+                    pbfluxes = {dataset: pbflux / distance**2 for dataset, pbflux in pbfluxes.items()}
+                    if 'lc' in ds_kinds_enabled or 'rv' in ds_kinds_enabled or 'lp' in ds_kinds_enabled:
+                        l3s = self.compute_l3s(compute=compute, use_pbfluxes=pbfluxes, ret_structured_dicts=True, skip_checks=True, skip_compute_ld_coeffs=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
+                    else:
+                        l3s = {}
+
+                else:
+                    if 'lc' in ds_kinds_enabled or 'rv' in ds_kinds_enabled or 'lp' in ds_kinds_enabled:
+                        logger.info("run_compute: computing necessary ld_coeffs, pblums, l3s")
+                        self.compute_ld_coeffs(compute=compute, skip_checks=True, set_value=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
+                        # NOTE that if pblum_method != 'phoebe', then system will be None
+                        # otherwise the system will be create which we can pass on to the backend
+                        # the phoebe backend can then skip initializing the system at least on the master proc
+                        # (workers will need to recreate the mesh)
+                        system, pblums_abs, pblums_scale, pblums_rel, pbfluxes = self.compute_pblums(compute=compute, ret_structured_dicts=True, skip_checks=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
+                        l3s = self.compute_l3s(compute=compute, use_pbfluxes=pbfluxes, ret_structured_dicts=True, skip_checks=True, skip_compute_ld_coeffs=True, **{k:v for k,v in kwargs.items() if k in computeparams.qualifiers})
+                    else:
+                        system = None
+                        pblums_abs = {}
+                        pblums_scale = {}
+                        pblums_rel = {}
+                        pbfluxes = {}
+                        l3s = {}
+
+                    logger.info("run_compute: calling {} backend to create '{}' model".format(computeparams.kind, model))
+                    if mpi.within_mpirun:
+                        logger.info("run_compute: within mpirun with nprocs={}".format(mpi.nprocs))
+                    compute_class = getattr(backends, '{}Backend'.format(computeparams.kind.title()))
+                    if computeparams.kind == 'phoebe':
+                        kwargs['system'] = system
+                        kwargs['pblums_scale'] = pblums_scale
+                    elif computeparams.kind in ['legacy', 'jktebop', 'ellc']:
+                        # legacy uses pblums directly
+                        # jktebop, ellc use pblums for sbratio if decoupled, otherwise will ignore and use teffs
+                        kwargs['pblums'] = pblums_rel
+
+                    ml_params = compute_class().run(self, computeparams.compute,
+                                                    dataset=dataset_this_compute,
+                                                    times=times,
+                                                    **kwargs)
+
+                    if backend_stage_key is not None:
+                        # NOTE: the key is updated as compute_ld_coeffs may have
+                        # changed the values of ld_coeffs
+                        backend_stage_key = self._get_backend_stage_key(compute, dataset_this_compute, times, kwargs)
+                        distance = self.get_value(qualifier='distance', context='system', unit=u.m, **_skip_filter_checks)
+                        self._backend_stage_cache[compute] = (backend_stage_key, ml_params.copy(), pblums_abs,
+                                                              {dataset: pbflux * distance**2 for dataset, pbflux in pbfluxes.items()})
+                    else:
+                        self._backend_stage_cache.pop(compute, None)
 
                 ml_addl_params = []
 
@@ -12327,7 +12443,8 @@ class Bundle(ParameterSet):
 
         return self.run_compute(model=model, **kwargs)
 
-    def import_model(self, fname, model=None, overwrite=False, return_changes=False):
+    def import_model(self, fname, model=None, overwrite=False, detach=False,
+                     return_changes=False):
         """
         Import and attach a model from a file.
 
@@ -12350,14 +12467,56 @@ class Bundle(ParameterSet):
             the tags in the file.
         * `overwrite` (bool, optional, default=False): overwrite the existing
             entry if it exists.
+        * `detach` (bool, optional, default=False): instead of loading the
+            model now, attach a <phoebe.parameters.JobParameter> that is
+            already complete, exactly as a detached
+            <phoebe.frontend.bundle.Bundle.run_compute> once it finishes.  The
+            model is then loaded (and relabeled to `model`) by
+            <phoebe.frontend.bundle.Bundle.attach_job>.  The contents of
+            `fname` are copied to the results file of the job without being
+            parsed.  `model` is required if `detach` is True.
         * `return_changes` (bool, optional, default=False): whether to include
             changed/removed parameters in the returned ParameterSet, including
             the removed parameters due to `overwrite`.
 
         Returns
         -----------
-        * ParameterSet of added and changed parameters
+        * ParameterSet of added and changed parameters (or the
+            <phoebe.parameters.JobParameter> if `detach` is True)
+
+        Raises
+        -----------
+        * ValueError: if `detach` is True but `model` is not provided.
         """
+        if detach:
+            if model is None:
+                raise ValueError("model must be provided if detach=True")
+            self._check_label(model, allow_overwrite=overwrite)
+
+            ret_changes = []
+            if model in self.models:
+                ret_changes += self.remove_model(model, during_overwrite=True, return_changes=return_changes).to_list()
+
+            job_param = JobParameter(self, job_name=None, uniqueid=_uniqueid())
+            if isinstance(fname, list):
+                with open(job_param._results_fname, 'w') as f:
+                    json.dump(fname, f)
+            elif isinstance(fname, str) and "{" in fname:
+                with open(job_param._results_fname, 'w') as f:
+                    f.write(fname)
+            else:
+                shutil.copyfile(os.path.expanduser(fname), job_param._results_fname)
+            job_param._value = 'complete'
+
+            self._attach_params([job_param], check_copy_for=False, context='model', model=model, server=None)
+
+            ret_changes += self._handle_model_selectparams(return_changes=return_changes)
+
+            ret_ps = ParameterSet([job_param])
+            if return_changes:
+                ret_ps += ret_changes
+            return ret_ps
+
         result_ps = ParameterSet.open(fname)
         metawargs = {}
         if model is None:
@@ -144,6 +144,15 @@ struct Tsphere {
 
   }
 
+  /*
+    Calculate Hessian matrix of the constrain
+  */
+  void hessian (T r[3], T H[3][3]){
+
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j) H[i][j] = (i == j ? 2 : 0);
+  }
+
   /*
     Initial point
   */
@@ -171,7 +171,7 @@ struct DoublePoint
 typedef void (*ZFillCallback)(IntPoint& e1bot, IntPoint& e1top, IntPoint& e2bot, IntPoint& e2top, IntPoint& pt);
 #endif
 
-enum InitOptions {ioReverseSolution = 1, ioStrictlySimple = 2, ioPreserveCollinear = 4};
+enum InitOptions {ioReverseSolution = 1, ioStrictlySimple = 2, ioPreserveCollinear = 4, ioPooled = 8};
 enum JoinType {jtSquare, jtRound, jtMiter};
 enum EndType {etClosedPolygon, etClosedLine, etOpenButt, etOpenSquare, etOpenRound};
 
@@ -258,8 +258,10 @@ struct OutPt;
 struct OutRec;
 struct Join;
 
+struct EdgeArray;
+
 typedef std::vector < OutRec* > PolyOutList;
-typedef std::vector < TEdge* > EdgeList;
+typedef std::vector < EdgeArray > EdgeList;
 typedef std::vector < Join* > JoinList;
 typedef std::vector < IntersectNode* > IntersectList;
 
@@ -276,11 +278,16 @@ public:
   bool AddPath(const Path &pg, PolyType PolyTyp, bool Closed);
   bool AddPaths(const Paths &ppg, PolyType PolyTyp, bool Closed);
   virtual void Clear();
+  void Clear(PolyType PolyTyp);
   IntRect GetBounds();
   bool PreserveCollinear() const {return m_PreserveCollinear;};
   void PreserveCollinear(bool value) {m_PreserveCollinear = value;};
+  bool Pooled() const {return m_Pooled;};
+  void Pooled(bool value) {m_Pooled = value;};
 protected:
   void DisposeLocalMinimaList();
+  TEdge* NewEdges(int size);
+  void DisposeEdges(TEdge *edges, int size);
   TEdge* AddBoundsToLML(TEdge *e, bool IsClosed);
   void PopLocalMinima();
   virtual void Reset();
@@ -302,6 +309,8 @@ protected:
   EdgeList          m_edges;
   bool             m_PreserveCollinear;
   bool             m_HasOpenPaths;
+  bool             m_Pooled;
+  std::vector<std::vector<TEdge*>> m_edgesPool; //free edge arrays by size
 };
 //------------------------------------------------------------------------------
 
@@ -348,6 +357,8 @@ private:
 #ifdef use_xyz
   ZFillCallback   m_ZFill; //custom callback
 #endif
+  std::vector<OutPt*>  m_OutPtPool;   //free nodes in pooled mode
+  std::vector<OutRec*> m_OutRecPool;
   void SetWindingCount(TEdge& edge);
   bool IsEvenOddFillType(const TEdge& edge) const;
   bool IsEvenOddAltFillType(const TEdge& edge) const;
@@ -376,6 +387,9 @@ private:
   OutPt* AddOutPt(TEdge *e, const IntPoint &pt);
   void DisposeAllOutRecs();
   void DisposeOutRec(PolyOutList::size_type index);
+  void DisposeOutPts(OutPt*& pp);
+  void DisposeOutPt(OutPt *pp);
+  OutPt* NewOutPt(int Idx, const IntPoint &Pt, OutPt *Next = 0, OutPt *Prev = 0);
   bool ProcessIntersections(const cInt topY);
   void BuildIntersectList(const cInt topY);
   void ProcessIntersectList();
@@ -576,6 +590,16 @@ struct TEdge {
 
 };
 
+//edge array allocated for a single path
+struct EdgeArray {
+  TEdge    *Edges;
+  int       Size;
+  PolyType  PolyTyp;
+
+  EdgeArray(TEdge *Edges, int Size, PolyType PolyTyp)
+  : Edges(Edges), Size(Size), PolyTyp(PolyTyp) {}
+};
+
 struct IntersectNode {
   TEdge          *Edge1;
   TEdge          *Edge2;
@@ -1442,12 +1466,35 @@ ClipperBase::ClipperBase() //constructor
 {
   m_CurrentLM = m_MinimaList.begin(); //begin() == end() here
   m_UseFullRange = false;
+  m_Pooled = false;
 }
 //------------------------------------------------------------------------------
 
 ClipperBase::~ClipperBase() //destructor
 {
   Clear();
+  for (auto && v : m_edgesPool) for (auto && e : v) delete [] e;
+}
+//------------------------------------------------------------------------------
+
+TEdge* ClipperBase::NewEdges(int size)
+{
+  if (m_Pooled && size < (int)m_edgesPool.size() && !m_edgesPool[size].empty()) {
+    TEdge *edges = m_edgesPool[size].back();
+    m_edgesPool[size].pop_back();
+    return edges;
+  }
+  return new TEdge [size];
+}
+//------------------------------------------------------------------------------
+
+void ClipperBase::DisposeEdges(TEdge *edges, int size)
+{
+  if (m_Pooled) {
+    if (size >= (int)m_edgesPool.size()) m_edgesPool.resize(size + 1);
+    m_edgesPool[size].push_back(edges);
+  } else
+    delete [] edges;
 }
 //------------------------------------------------------------------------------
 
@@ -1725,7 +1772,7 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   //
   bool IsFlat = true;
 
-  TEdge *edges = new TEdge [size];
+  TEdge *edges = NewEdges(size);
 
   try
   {
@@ -1762,7 +1809,7 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   }
   catch(...)
   {
-    delete [] edges;
+    DisposeEdges(edges, size);
     throw; //range test fails
   }
 
@@ -1803,7 +1850,7 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
 
   if ((!Closed && (E == E->Next)) || (Closed && (E->Prev == E->Next)))
   {
-    delete [] edges;
+    DisposeEdges(edges, size);
     return false;
   }
 
@@ -1831,7 +1878,7 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   {
     if (Closed)
     {
-      delete [] edges;
+      DisposeEdges(edges, size);
       return false;
     }
 
@@ -1859,11 +1906,11 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
     }
 
     //m_MinimaList.push_back(locMin);
-    m_edges.push_back(edges);
+    m_edges.emplace_back(edges, size, PolyTyp);
 	  return true;
   }
 
-  m_edges.push_back(edges);
+  m_edges.emplace_back(edges, size, PolyTyp);
   bool leftBoundIsForward;
   TEdge* EMin = 0;
 
@@ -1948,7 +1995,7 @@ void ClipperBase::Clear()
   }
   */
 
-  for (auto && e : m_edges) delete [] e;
+  for (auto && e : m_edges) DisposeEdges(e.Edges, e.Size);
   m_edges.clear();
 
   m_UseFullRange = false;
@@ -1956,6 +2003,37 @@ void ClipperBase::Clear()
 }
 //------------------------------------------------------------------------------
 
+void ClipperBase::Clear(PolyType PolyTyp)
+{
+  //removes only the paths of the given type, so that the remaining ones
+  //(e.g. the clip paths) are kept for the next Execute without being added
+  //again. Local minima are the only references to the edges kept between
+  //executions.
+
+  auto lm_end = std::remove_if(m_MinimaList.begin(), m_MinimaList.end(),
+    [PolyTyp](const LocalMinimum & lm) {
+      return (lm.LeftBound ? lm.LeftBound : lm.RightBound)->PolyTyp == PolyTyp;
+    });
+
+  m_MinimaList.erase(lm_end, m_MinimaList.end());
+  m_CurrentLM = m_MinimaList.begin();
+
+  auto e_end = std::remove_if(m_edges.begin(), m_edges.end(),
+    [this, PolyTyp](const EdgeArray & e) {
+      if (e.PolyTyp != PolyTyp) return false;
+      DisposeEdges(e.Edges, e.Size);
+      return true;
+    });
+
+  m_edges.erase(e_end, m_edges.end());
+
+  if (m_edges.empty()) {
+    m_UseFullRange = false;
+    m_HasOpenPaths = false;
+  }
+}
+//------------------------------------------------------------------------------
+
 void ClipperBase::Reset()
 {
   m_CurrentLM = m_MinimaList.begin();
@@ -2089,6 +2167,7 @@ Clipper::Clipper(int initOptions) : ClipperBase() //constructor
   m_ReverseOutput = ((initOptions & ioReverseSolution) != 0);
   m_StrictSimple = ((initOptions & ioStrictlySimple) != 0);
   m_PreserveCollinear = ((initOptions & ioPreserveCollinear) != 0);
+  m_Pooled = ((initOptions & ioPooled) != 0);
   m_HasOpenPaths = false;
 #ifdef use_xyz
   m_ZFill = 0;
@@ -2099,6 +2178,8 @@ Clipper::Clipper(int initOptions) : ClipperBase() //constructor
 Clipper::~Clipper() //destructor
 {
   Clear();
+  for (auto && p : m_OutPtPool) delete p;
+  for (auto && p : m_OutRecPool) delete p;
 }
 //------------------------------------------------------------------------------
 
@@ -2265,7 +2346,10 @@ void Clipper::DisposeAllOutRecs(){
 
   for (auto && p : m_PolyOuts) {
     if (p->Pts) DisposeOutPts(p->Pts);
-    delete p;
+    if (m_Pooled)
+      m_OutRecPool.push_back(p);
+    else
+      delete p;
   }
   m_PolyOuts.clear();
 }
@@ -2275,11 +2359,47 @@ void Clipper::DisposeOutRec(PolyOutList::size_type index)
 {
   OutRec *outRec = m_PolyOuts[index];
   if (outRec->Pts) DisposeOutPts(outRec->Pts);
-  delete outRec;
+  if (m_Pooled)
+    m_OutRecPool.push_back(outRec);
+  else
+    delete outRec;
   m_PolyOuts[index] = 0;
 }
 //------------------------------------------------------------------------------
 
+void Clipper::DisposeOutPts(OutPt*& pp)
+{
+  if (pp == 0) return;
+  pp->Prev->Next = 0;
+  while( pp )
+  {
+    OutPt *tmpPp = pp;
+    pp = pp->Next;
+    DisposeOutPt(tmpPp);
+  }
+}
+//------------------------------------------------------------------------------
+
+void Clipper::DisposeOutPt(OutPt *pp)
+{
+  if (m_Pooled)
+    m_OutPtPool.push_back(pp);
+  else
+    delete pp;
+}
+//------------------------------------------------------------------------------
+
+OutPt* Clipper::NewOutPt(int Idx, const IntPoint &Pt, OutPt *Next, OutPt *Prev)
+{
+  if (m_OutPtPool.empty()) return new OutPt(Idx, Pt, Next, Prev);
+
+  OutPt *result = m_OutPtPool.back();
+  m_OutPtPool.pop_back();
+  *result = OutPt(Idx, Pt, Next, Prev);
+  return result;
+}
+//------------------------------------------------------------------------------
+
 void Clipper::SetWindingCount(TEdge &edge)
 {
   TEdge *e = edge.PrevInAEL;
@@ -3177,7 +3297,15 @@ OutRec* Clipper::CreateOutRec()
   m_PolyOuts.push_back(result);
   result->Idx = (int)m_PolyOuts.size()-1;
 */
-  OutRec* result = new OutRec(m_PolyOuts.size());
+  OutRec* result;
+
+  if (m_OutRecPool.empty())
+    result = new OutRec(m_PolyOuts.size());
+  else {
+    result = m_OutRecPool.back();
+    m_OutRecPool.pop_back();
+    *result = OutRec(m_PolyOuts.size());
+  }
   m_PolyOuts.push_back(result);
 
   return result;
@@ -3200,7 +3328,7 @@ OutPt* Clipper::AddOutPt(TEdge *e, const IntPoint &pt)
     newOp->Next = newOp;
     newOp->Prev = newOp;
     */
-    OutPt* newOp = new OutPt(outRec->Idx, pt);
+    OutPt* newOp = NewOutPt(outRec->Idx, pt);
     newOp->Next = newOp->Prev = outRec->Pts = newOp;
 
     if (!outRec->IsOpen) SetHoleState(e, outRec);
@@ -3225,7 +3353,7 @@ OutPt* Clipper::AddOutPt(TEdge *e, const IntPoint &pt)
     newOp->Prev->Next = newOp;
     */
 
-    OutPt* newOp = new OutPt(outRec->Idx, pt, op, op->Prev);
+    OutPt* newOp = NewOutPt(outRec->Idx, pt, op, op->Prev);
     newOp->Prev->Next = newOp;
 
     op->Prev = newOp;
@@ -3919,7 +4047,7 @@ void Clipper::FixupOutPolygon(OutRec &outrec)
       pp->Prev->Next = pp->Next;
       pp->Next->Prev = pp->Prev;
       pp = pp->Prev;
-      delete tmp;
+      DisposeOutPt(tmp);
     }
     else if (pp == lastOK) break;
     else
@@ -947,7 +947,8 @@ void triangle_mesh_visibility_boolean(
 
     int *t;
 
-    ClipperLib::Clipper c;    // clipping engine
+    // clipping engine recycling its nodes between triangles
+    ClipperLib::Clipper c(ClipperLib::ioPooled);
 
     ClipperLib::Paths S, P;   // shadow (image on the screen) and remainder
 
@@ -979,16 +980,24 @@ void triangle_mesh_visibility_boolean(
 
     double r;
 
+    bool S_changed = true;  // is the shadow in the engine out of date
+
     while (++it != it_end) { // loop over visible triangles
 
       t = Tr[it->index].data;
 
       for (int i = 0; i < 3; ++i) s[i] = VsI[t[i]];
 
-      // Loading polygons
-      c.Clear();
+      // Loading polygons: the shadow is kept in the engine as long as
+      // it does not change, only the triangle is replaced
+      c.Clear(ClipperLib::ptSubject);
       c.AddPath(s, ClipperLib::ptSubject, true); // triangle T
-      c.AddPaths(S, ClipperLib::ptClip, true);   // shadow  S
+
+      if (S_changed) {
+        c.Clear(ClipperLib::ptClip);
+        c.AddPaths(S, ClipperLib::ptClip, true); // shadow  S
+        S_changed = false;
+      }
 
        // calculate remainder: P = T - S
        // P is the visible part of T
@@ -1048,6 +1057,8 @@ void triangle_mesh_visibility_boolean(
       // S is the new "shadow" aka picture at the screen
       c.Execute(ClipperLib::ctUnion, S, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 
+      S_changed = true;
+
       // clean the shadow
       ClipperLib::CleanPolygonsDefault(S);
 
@@ -1274,6 +1285,12 @@ void cut_triangle_based_on_mu(
     M - vector of the fractions of triangle that is visible
     W - weights for averaging over visible area of triangles
     H - horizon given in indices of vertices
+    C[4] - statistics of the cuts along the mu = 0 horizon, numbers of
+      triangles that are
+        C[0] - back-facing (all mu < 0)
+        C[1] - forward-facing (all mu >= 0)
+        C[2] - cut to a triangle (one mu >= 0)
+        C[3] - cut to a quadrilateral (two mu >= 0)
 
   Ref:
   * http://web.cecs.pdx.edu/~karlaf/CS447_Slides/Set5.pdf
@@ -1289,10 +1306,11 @@ void triangle_mesh_visibility_linear(
   std::vector<T3Dpoint<T>> & N,
   std::vector<T> *M = 0,
   std::vector<T3Dpoint<T>> *W = 0,
-  std::vector<std::vector<int>> *H = 0)
+  std::vector<std::vector<int>> *H = 0,
+  int *C = 0)
 {
 
-  if (M == 0 && W == 0 && H == 0) return;
+  if (M == 0 && W == 0 && H == 0 && C == 0) return;
 
   //
   // Defining the on-screen vector basis (t1,t2,view)
@@ -1342,6 +1360,10 @@ void triangle_mesh_visibility_linear(
   std::vector<int> Vi;  // indices of visual points
   std::vector<Tt> Tv;   // vector of potentially visible triangles
 
+  // number of triangles per sign mask of vertex-mu-s
+  // bit j of the mask is set if mu[j] >= 0
+  int Nm[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
   //  Bounding box of all triangles on the screen
   T bb[4] = {
       +std::numeric_limits<T>::max(),
@@ -1366,8 +1388,13 @@ void triangle_mesh_visibility_linear(
         mu[j] = n[0]*view[0] + n[1]*view[1] + n[2]*view[2];
       }
 
+      // classify the triangle by the signs of mu-s without branching
+      int m = int(mu[0] >= 0) | (int(mu[1] >= 0) << 1) | (int(mu[2] >= 0) << 2);
+
+      ++Nm[m];
+
       // if at least one vertex is visible
-      if (mu[0] >= 0 || mu[1] >= 0 || mu[2] >= 0) {
+      if (m) {
 
         // calculate projection onto screen
         for (int j = 0; j < 3; ++j) {
@@ -1395,6 +1422,13 @@ void triangle_mesh_visibility_linear(
 
   Vst.clear();
 
+  if (C) {
+    C[0] = Nm[0];
+    C[1] = Nm[7];
+    C[2] = Nm[1] + Nm[2] + Nm[4];
+    C[3] = Nm[3] + Nm[5] + Nm[6];
+  }
+
   //
   // Lets do eclipsing
   //
@@ -1445,7 +1479,8 @@ void triangle_mesh_visibility_linear(
 
     int *t;
 
-    ClipperLib::Clipper c;      // clipping engine
+    // clipping engine recycling its nodes between triangles
+    ClipperLib::Clipper c(ClipperLib::ioPooled);
 
     ClipperLib::Paths S, P;     // shadow (image on the screen) and remainder
 
@@ -1482,10 +1517,13 @@ void triangle_mesh_visibility_linear(
 
     double r;
 
+    bool S_changed = true;  // is the shadow in the engine out of date
+
     while (++it != it_end) {
 
-      // Loading polygons
-      c.Clear();
+      // Loading polygons: the shadow is kept in the engine as long as
+      // it does not change, only the triangle is replaced
+      c.Clear(ClipperLib::ptSubject);
 
       t = Tr[it->index].data;
 
@@ -1503,7 +1541,11 @@ void triangle_mesh_visibility_linear(
       }
 
       // calculate the shadow S
-      c.AddPaths(S, ClipperLib::ptClip, true);
+      if (S_changed) {
+        c.Clear(ClipperLib::ptClip);
+        c.AddPaths(S, ClipperLib::ptClip, true);
+        S_changed = false;
+      }
 
       // calculate remainder: P = T - S
       // P is the visible part of T
@@ -1564,6 +1606,8 @@ void triangle_mesh_visibility_linear(
       // S is the new "shadow" aka picture at the screen
       c.Execute(ClipperLib::ctUnion, S, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 
+      S_changed = true;
+
       // clean the shadow
       ClipperLib::CleanPolygonsDefault(S);
 
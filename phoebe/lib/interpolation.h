@@ -4,12 +4,19 @@
   Library for interpolation of data. Currently supporting:
 
   * multi-dimensional linear interpolation based on gridded data
+  * imputing missing values of gridded data
+  * constructing gridded data from scattered rows of parameters
+  * evaluation of 1D B-splines given by knots and coefficients
+  * multi-dimensional cubic (B-spline, Catmull-Rom) interpolation
+    based on gridded data
 
   Author: Martin Horvat, September 2016
 */
 
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include "utils.h"
 
@@ -88,7 +95,7 @@ struct Tlinear_interpolation {
 
   // own data
 
-  T *lo, *hi, *prod, **n, **fvv, *__ret;
+  T *lo, *hi, *prod, **fvv, *__ret;
 
   int *axelen, *axidx, Nf;
 
@@ -115,7 +122,11 @@ struct Tlinear_interpolation {
 
     axidx = new int [Na];
 
-    n = utils::matrix<T>(Nf, Na);   // space to hold all the nodes
+    for (int j = Na-1; j >= 0; --j) {
+      axidx[j] = 0;
+      prod[j] = (j == Na - 1) ? 1.0 : prod[j+1]*L[j+1];
+    }
+
     fvv = utils::matrix<T>(Nf, Nv); // function value arrays
   }
 
@@ -124,7 +135,6 @@ struct Tlinear_interpolation {
     delete [] lo;
     delete [] axidx;
 
-    utils::free_matrix(n);
     utils::free_matrix(fvv);
   }
 
@@ -144,14 +154,23 @@ struct Tlinear_interpolation {
   */
   bool get(T *x, T *r) {
 
-    T *g;
+    T *g, t;
 
     int j, k, l, m, o, idx;
 
     // Run the axes first to make sure interpolation is possible.
     for (j = Na-1; j >= 0; --j) {
+
+      // consecutive points often lie in the same cell, so the cell of
+      // the previous point is reused if it contains x[j]
+      if (axidx[j] > 0 && A[j][axidx[j]-1] <= x[j] && x[j] < A[j][axidx[j]])
+        continue;
+
       axidx[j] = utils::flt(x[j], A[j], L[j]);
 
+      // x[j] exactly at the last node is handled by the last interval
+      if (axidx[j] == L[j]) axidx[j] = L[j] - 1;
+
       // AN OUT-OF-BOUNDS SITUATION -- both sides handled.
       if (axidx[j] < 1) {
         for (l = 0; l < Nv; ++l) r[l] = std::numeric_limits<T>::quiet_NaN();
@@ -162,7 +181,6 @@ struct Tlinear_interpolation {
     for (j = Na-1; j >= 0; --j) {
       lo[j] = A[j][axidx[j]-1];
       hi[j] = A[j][axidx[j]];
-      prod[j] = (j == Na - 1) ? 1.0 : prod[j+1]*L[j+1];
     }
 
     for (k = 0; k < Nf; ++k) {
@@ -174,21 +192,51 @@ struct Tlinear_interpolation {
       for (l = 0; l < Nv; ++l) fvv[k][l] = g[l];
     }
 
-    // Populate the nodes:
-    for (k = 0; k < Na; ++k)
-      for (j = 0; j < Nf; ++j)
-        n[j][k] = lo[k] + ((j >> k) & 1)*(hi[k] - lo[k]);
-
-    for (k = 0, o = Na - 1, m = Nf >> 1; k < Na; ++k, --o, m >>=1)
+    // Reduce along the axes: in step k nodes j < m lie on the lower and
+    // nodes j + m on the upper side of the cell along axis o.
+    for (k = 0, o = Na - 1, m = Nf >> 1; k < Na; ++k, --o, m >>=1) {
+      t = (x[o] - lo[o])/(hi[o] - lo[o]);
       for (j = 0; j < m; ++j)
         for (l = 0; l < Nv; ++l)
-          fvv[j][l] += (x[o] - n[j][o])*(fvv[j + m][l] - fvv[j][l])/(n[j + m][o] - n[j][o]);
+          fvv[j][l] += t*(fvv[j + m][l] - fvv[j][l]);
+    }
 
     for (l = 0; l < Nv; ++l) r[l] = fvv[0][l];
 
     return true;
   }
 
+  /*
+    Clamping the point to the range of the axes, i.e. replacing each
+    coordinate outside of the axis range by the nearest boundary value.
+
+    Input:
+      x - array of dimension Na
+
+    Output:
+      y - array of dimension Na
+
+    Return:
+      true - if any coordinate was clamped, false - otherwise
+  */
+  bool clamp(T *x, T *y) {
+
+    bool clamped = false;
+
+    for (int j = 0; j < Na; ++j) {
+      if (x[j] < A[j][0]) {
+        y[j] = A[j][0];
+        clamped = true;
+      } else if (x[j] > A[j][L[j] - 1]) {
+        y[j] = A[j][L[j] - 1];
+        clamped = true;
+      } else
+        y[j] = x[j];
+    }
+
+    return clamped;
+  }
+
   /*
     Performing interpolation
 
@@ -211,3 +259,627 @@ struct Tlinear_interpolation {
   }
 
 };
+
+/*
+  Class for evaluation of 1D B-spline of degree k given by knots and
+  coefficients, i.e. in the form (t, c, k) as returned e.g. by
+
+    scipy.interpolate.splrep
+
+  The spline is given by
+
+    S(x) = sum_{i = 0}^{n-k-2} c_i B_{i,k}(x)
+
+  with n the number of knots. Outside of the range [t_k, t_{n-k-1}]
+  the spline is extrapolated using the first/last polynomial piece.
+
+  Evaluation is done by de Boor's algorithm.
+
+  Notes:
+  * data is copied so the object can be used persistently
+  * the degree is limited to k <= 7, typically k = 3
+*/
+
+template <class T>
+struct Tbspline {
+
+  int n, k;
+
+  std::vector<T> t, c;
+
+  /*
+    Initialization of the spline.
+
+    Input:
+      n - number of knots
+      t - knots in ascending order
+      c - coefficients, at least n - k - 1 are used
+      k - degree of the spline
+  */
+  Tbspline(const int &n, T *t, T *c, const int &k)
+    : n(n), k(k), t(t, t + n), c(c, c + n - k - 1) {}
+
+  /*
+    Index l of the knot interval [t_l, t_{l+1}) containing x
+    restricted to k <= l <= n - k - 2.
+  */
+  int interval(const T &x) const {
+
+    int lo = k, hi = n - k - 1, mid;
+
+    // binary search for the last knot t_l <= x
+    while (hi - lo > 1) {
+      mid = (lo + hi) >> 1;
+      if (t[mid] <= x) lo = mid; else hi = mid;
+    }
+
+    return lo;
+  }
+
+  /*
+    Evaluate the spline at x.
+
+    Input:
+      x - argument
+
+    Return:
+      S(x)
+  */
+  T operator()(const T &x) const {
+
+    int l = interval(x);
+
+    T d[8], a;
+
+    const T *tl = t.data() + l - k;
+
+    for (int j = 0; j <= k; ++j) d[j] = c[j + l - k];
+
+    for (int r = 1; r <= k; ++r)
+      for (int j = k; j >= r; --j) {
+        a = (x - tl[j])/(tl[j + 1 + k - r] - tl[j]);
+        d[j] = (1 - a)*d[j - 1] + a*d[j];
+      }
+
+    return d[k];
+  }
+
+  /*
+    Evaluate the spline at an array of arguments.
+
+    Input:
+      m - number of arguments
+      x - array of arguments
+
+    Output:
+      y - array of values S(x)
+  */
+  void eval(const int &m, T *x, T *y) const {
+
+    if (k == 3) {
+
+      // unrolled de Boor algorithm for cubic splines
+      T d0, d1, d2, d3, xi;
+
+      const T *tl;
+
+      for (int i = 0; i < m; ++i) {
+
+        xi = x[i];
+
+        int l = interval(xi);
+
+        tl = t.data() + l - 3;
+
+        d0 = c[l - 3];
+        d1 = c[l - 2];
+        d2 = c[l - 1];
+        d3 = c[l];
+
+        d3 = d2 + (xi - tl[3])/(tl[6] - tl[3])*(d3 - d2);
+        d2 = d1 + (xi - tl[2])/(tl[5] - tl[2])*(d2 - d1);
+        d1 = d0 + (xi - tl[1])/(tl[4] - tl[1])*(d1 - d0);
+
+        d3 = d2 + (xi - tl[3])/(tl[5] - tl[3])*(d3 - d2);
+        d2 = d1 + (xi - tl[2])/(tl[4] - tl[2])*(d2 - d1);
+
+        d3 = d2 + (xi - tl[3])/(tl[4] - tl[3])*(d3 - d2);
+
+        y[i] = d3;
+      }
+
+    } else
+      for (int i = 0; i < m; ++i) y[i] = (*this)(x[i]);
+  }
+};
+
+/*
+  Class for multi-dimensional cubic interpolation based on gridded data
+  described in the same way as in Tlinear_interpolation. The
+  interpolation is a tensor product of 1D cubic kernels in the index
+  space of the grid, i.e. a point x is first mapped to fractional
+  indices
+
+    u_i = j + (x_i - a_{i,j})/(a_{i,j+1} - a_{i,j}),   a_{i,j} <= x_i <= a_{i,j+1}
+
+  and the value is
+
+    Interpolation(x) = sum_{k} C[k] prod_i w(u_i - k_i)
+
+  summed over the 4^Na nearest nodes k. Supported kernels are
+
+    cubic_bspline - cubic B-spline, C are the prefiltered coefficients
+                    such that the interpolation passes through the data,
+                    the result is C^2 smooth
+    cubic_catmull_rom - Catmull-Rom spline, C = G, the result is C^1
+                    smooth and needs no prefiltering
+
+  Nodes beyond the ends of the axes are mirrored, i.e. the grid is
+  extended symmetrically about the first and last node. The prefilter
+  is the recursive filter of Unser et al, IEEE Trans. Sig. Proc. 41
+  (1993) 821, with the same boundary conditions.
+
+  Notes:
+  * data is copied so the object can be used persistently
+  * !!!NOT-THREAD SAVE!!!
+  * missing (NaN) nodes spread over the whole grid lines in the
+    prefilter, the grid should be imputed beforehand (see impute_grid)
+*/
+
+enum Tcubic_kernel {
+  cubic_bspline,
+  cubic_catmull_rom
+};
+
+template <class T>
+struct Tcubic_interpolation {
+
+  int Na, Nv;
+
+  Tcubic_kernel kernel;
+
+  std::vector<int> L, S;      // lengths and strides (in nodes) of axes
+
+  std::vector<std::vector<T>> A;
+
+  std::vector<T> C;           // coefficients at nodes
+
+  // work space: offsets (in values), weights of the 4 nodes along
+  // each axis and the multi-index of the current node
+  std::vector<int> off, idx;
+
+  std::vector<T> w;
+
+  /*
+    Initialization of the interpolation.
+
+    Input:
+      Na - number of axes
+      Nv - number of values in data points/dimension of interpolated values
+      L - numbers of points on axes
+      A - pointers to values on axes given in ascending order
+      G - pointer the values of the grid (tensor)
+      kernel - type of the cubic kernel
+  */
+  Tcubic_interpolation(
+    const int &Na,
+    const int &Nv,
+    int *L,
+    T **A,
+    T *G,
+    const Tcubic_kernel & kernel = cubic_bspline)
+  : Na(Na), Nv(Nv), kernel(kernel), L(L, L + Na), S(Na), A(Na),
+    off(4*Na), idx(Na), w(4*Na) {
+
+    int N = 1;
+
+    for (int i = Na - 1; i >= 0; --i) {
+      S[i] = N;
+      N *= L[i];
+      this->A[i].assign(A[i], A[i] + L[i]);
+    }
+
+    C.assign(G, G + N*Nv);
+
+    if (kernel == cubic_bspline) prefilter();
+  }
+
+  /*
+    Performing interpolation
+
+      r = interpolation(x)
+
+    Input:
+      x - array of dimension Na
+
+    Output:
+      r - array of dimension Nv
+
+    Return:
+      false - out of bounds, true - otherwise
+  */
+  bool get(T *x, T *r) {
+
+    for (int i = 0; i < Na; ++i) {
+
+      const std::vector<T> & a = A[i];
+
+      int n = L[i], j;
+
+      if (!(x[i] >= a[0] && x[i] <= a[n - 1])) return false;
+
+      if (n == 1) {
+        for (int k = 0; k < 4; ++k) {
+          off[4*i + k] = 0;
+          w[4*i + k] = (k == 1 ? 1 : 0);
+        }
+        continue;
+      }
+
+      j = std::upper_bound(a.begin(), a.end() - 1, x[i]) - a.begin() - 1;
+      if (j > n - 2) j = n - 2;
+
+      T t = (x[i] - a[j])/(a[j + 1] - a[j]);
+
+      weights(t, w.data() + 4*i);
+
+      for (int k = 0; k < 4; ++k)
+        off[4*i + k] = mirror(j + k - 1, n)*S[i]*Nv;
+    }
+
+    for (int k = 0; k < Nv; ++k) r[k] = 0;
+
+    // sum over the 4^Na nodes
+    for (int i = 0; i < Na; ++i) idx[i] = 0;
+
+    while (true) {
+
+      T f = 1;
+
+      int o = 0;
+
+      for (int i = 0; i < Na; ++i) {
+        f *= w[4*i + idx[i]];
+        o += off[4*i + idx[i]];
+      }
+
+      if (f != 0) {
+        const T *c = C.data() + o;
+        for (int k = 0; k < Nv; ++k) r[k] += f*c[k];
+      }
+
+      int i = Na - 1;
+      while (i >= 0 && ++idx[i] == 4) idx[i--] = 0;
+      if (i < 0) break;
+    }
+
+    return true;
+  }
+
+  private:
+
+  /*
+    Mirroring index i into the range [0, n-1] with whole-sample symmetry.
+  */
+  static int mirror(int i, const int & n) {
+    if (n == 1) return 0;
+    int p = 2*(n - 1);
+    i %= p;
+    if (i < 0) i += p;
+    return (i < n ? i : p - i);
+  }
+
+  /*
+    Weights of the nodes j-1, j, j+1, j+2 at t in [0,1] relative to j.
+  */
+  void weights(const T & t, T *w) {
+
+    T t2 = t*t, t3 = t2*t;
+
+    if (kernel == cubic_bspline) {
+      T s = 1 - t;
+      w[0] = s*s*s/6;
+      w[1] = (3*t3 - 6*t2 + 4)/6;
+      w[2] = (-3*t3 + 3*t2 + 3*t + 1)/6;
+      w[3] = t3/6;
+    } else {
+      w[0] = (-t3 + 2*t2 - t)/2;
+      w[1] = (3*t3 - 5*t2 + 2)/2;
+      w[2] = (-3*t3 + 4*t2 + t)/2;
+      w[3] = (t3 - t2)/2;
+    }
+  }
+
+  /*
+    Transforming the grid values into cubic B-spline coefficients by
+    applying the 1D prefilter along all lines of all axes.
+  */
+  void prefilter() {
+
+    const T z = std::sqrt(T(3)) - 2;
+
+    int N = C.size()/Nv;
+
+    std::vector<T> c;
+
+    for (int i = 0; i < Na; ++i) {
+
+      int n = L[i], s = S[i]*Nv;
+
+      if (n == 1) continue;
+
+      c.resize(n);
+
+      // powers of z used in the initialization of the causal filter
+      T zn = std::pow(z, n - 1), z2n = zn*zn;
+
+      for (int u = 0; u < N; ++u) if ((u/S[i]) % n == 0)
+        for (int k = 0; k < Nv; ++k) {
+
+          T *g = C.data() + u*Nv + k;
+
+          // causal initialization, exact for mirror boundaries
+          T sum = g[0] + zn*g[(n - 1)*s], zi = z, zj = zn*zn/z;
+
+          for (int j = 1; j < n - 1; ++j, zi *= z, zj /= z)
+            sum += (zi + zj)*g[j*s];
+
+          c[0] = 6*sum/(1 - z2n);
+
+          for (int j = 1; j < n; ++j) c[j] = 6*g[j*s] + z*c[j - 1];
+
+          // anti-causal filter
+          c[n - 1] = z/(z*z - 1)*(c[n - 1] + z*c[n - 2]);
+
+          for (int j = n - 2; j >= 0; --j) c[j] = z*(c[j + 1] - c[j]);
+
+          for (int j = 0; j < n; ++j) g[j*s] = c[j];
+        }
+    }
+  }
+};
+
+/*
+  Status flags of the interpolation of a point used by the batch
+  interpolation with out-of-bounds policies:
+
+    interp_out_of_bounds - point was outside of the axes' ranges
+    interp_missing_node - point was in a hypercube with a missing (NaN) node
+    interp_clamped - point was clamped to the axes' ranges
+    interp_fallback - value was obtained from the fallback grid
+    interp_failed - no policy produced a value, the result is NaN
+*/
+enum Tinterp_status {
+  interp_ok = 0,
+  interp_out_of_bounds = 1,
+  interp_missing_node = 2,
+  interp_clamped = 4,
+  interp_fallback = 8,
+  interp_failed = 16
+};
+
+/*
+  Imputing missing nodes of gridded data, i.e. replacing NaN values
+  on the grid by linear interpolation from the valid neighbouring
+  nodes. The grid is described in the same way as in
+  Tlinear_interpolation and is changed in place.
+
+  A node u is considered missing if its first value G[u,0] is NaN.
+  For a missing node we search along each axis i for the nearest valid
+  nodes on the left and right side
+
+    u_l = u - k_l e_i,   u_r = u + k_r e_i
+
+  and, if both exist, take the linear estimate
+
+    V_i = V_{u_l} + (a(u) - a(u_l))(V_{u_r} - V_{u_l})/(a(u_r) - a(u_l))
+
+  where a are the values on the i-th axis or indices if A is NULL.
+  The imputed value is the average of all available V_i. The procedure
+  is repeated on the updated grid until no new node can be filled.
+  Nodes that are not bracketed along any axis remain NaN, similarly as
+  the nodes outside of the convex hull of the valid nodes in the
+  N-dimensional linear interpolation.
+
+  Input:
+    Na - number of axes
+    Nv - number of values in data points/dimension of interpolated values
+    L - numbers of points on axes
+    A - pointers to values on axes given in ascending order or NULL
+    G - pointer the values of the grid (tensor)
+    max_iter - maximal number of sweeps over the grid
+
+  Output:
+    G - grid with imputed nodes
+
+  Return:
+    number of imputed nodes
+*/
+
+template <class T>
+int impute_grid(
+  const int &Na,
+  const int &Nv,
+  int *L,
+  T **A,
+  T *G,
+  const int &max_iter = 100) {
+
+  int N = 1;
+
+  for (int i = 0; i < Na; ++i) N *= L[i];
+
+  // strides of individual axes in units of nodes
+  std::vector<int> S(Na);
+
+  S[Na - 1] = 1;
+  for (int i = Na - 2; i >= 0; --i) S[i] = S[i + 1]*L[i + 1];
+
+  std::vector<char> valid(N);
+
+  for (int u = 0; u < N; ++u) valid[u] = !std::isnan(G[u*Nv]);
+
+  std::vector<int> filled;
+
+  std::vector<T> buf, w(Nv);
+
+  int nr_imputed = 0;
+
+  for (int it = 0; it < max_iter; ++it) {
+
+    filled.clear();
+    buf.clear();
+
+    for (int u = 0; u < N; ++u) if (!valid[u]) {
+
+      int cnt = 0, c, k, l, r;
+
+      for (k = 0; k < Nv; ++k) w[k] = 0;
+
+      for (int i = 0; i < Na; ++i) {
+
+        c = (u/S[i]) % L[i];     // index of node on i-th axis
+
+        // searching for the nearest valid nodes on both sides
+        for (k = c - 1; k >= 0 && !valid[u + (k - c)*S[i]]; --k);
+        if (k < 0) continue;
+        l = k;
+
+        for (k = c + 1; k < L[i] && !valid[u + (k - c)*S[i]]; ++k);
+        if (k >= L[i]) continue;
+        r = k;
+
+        T t = (A ?
+          (A[i][c] - A[i][l])/(A[i][r] - A[i][l]) :
+          T(c - l)/(r - l));
+
+        T *gl = G + (u + (l - c)*S[i])*Nv,
+          *gr = G + (u + (r - c)*S[i])*Nv;
+
+        for (k = 0; k < Nv; ++k) w[k] += gl[k] + t*(gr[k] - gl[k]);
+
+        ++cnt;
+      }
+
+      if (cnt) {
+        filled.push_back(u);
+        for (k = 0; k < Nv; ++k) buf.push_back(w[k]/cnt);
+      }
+    }
+
+    if (filled.empty()) break;
+
+    // committing the sweep so that the result is independent of the
+    // order in which the nodes were visited
+    {
+      auto b = buf.begin();
+      for (auto && u : filled) {
+        std::copy(b, b + Nv, G + u*Nv);
+        b += Nv;
+        valid[u] = 1;
+      }
+    }
+
+    nr_imputed += filled.size();
+  }
+
+  return nr_imputed;
+}
+
+/*
+  Constructing the axes of gridded data from scattered rows of
+  parameters. Each parameter is a column of Ng values
+
+    P[i*Ng + k]  i = 0, .., Na-1,  k = 0, .., Ng-1
+
+  and each axis A_i is formed by the sorted unique values of the i-th
+  parameter. For each row k we return the index of the node
+
+    u_k = sum_i j_{i,k} S_i,   a_{i, j_{i,k}} = P[i*Ng + k]
+
+  where S_i are strides of the axes as in Tlinear_interpolation, so that
+  the data of the row can be scattered into the grid at G[u_k*Nv + ...].
+
+  Input:
+    Na - number of parameters/axes
+    Ng - number of rows
+    P - pointer to the parameters
+
+  Output:
+    A - values on axes in ascending order
+    U - indices of nodes of rows
+
+  Return:
+    number of nodes of the grid
+*/
+
+template <class T>
+long grid_axes(
+  const int &Na,
+  const long &Ng,
+  T *P,
+  std::vector<std::vector<T>> & A,
+  std::vector<long> & U) {
+
+  A.resize(Na);
+
+  U.assign(Ng, 0);
+
+  long N = 1;
+
+  for (int i = 0; i < Na; ++i) {
+
+    T *p = P + i*Ng;
+
+    std::vector<T> & a = A[i];
+
+    // collecting unique values into a sorted vector, there are typically
+    // much less unique values than rows and rows are often ordered
+    a.clear();
+
+    for (long k = 0; k < Ng; ++k) {
+
+      if (k > 0 && p[k] == p[k - 1]) continue;
+
+      auto it = a.begin();
+
+      if (a.size() <= 64)
+        for (auto && b : a) it += (b < p[k]);
+      else
+        it = std::lower_bound(a.begin(), a.end(), p[k]);
+
+      if (it == a.end() || *it != p[k]) {
+        if (a.size() < 4096)
+          a.insert(it, p[k]);
+        else {   // too many values for insertion, sorting all of them
+          a.assign(p, p + Ng);
+          std::sort(a.begin(), a.end());
+          a.erase(std::unique(a.begin(), a.end()), a.end());
+          break;
+        }
+      }
+    }
+
+    long l = a.size(), j = 0;
+
+    if (l <= 64) {  // short axes: branchless counting is faster than bisection
+      T *b = a.data();
+      for (long k = 0; k < Ng; ++k) {
+        if (k == 0 || p[k] != p[k - 1]) {
+          j = 0;
+          for (long m = 0; m < l; ++m) j += (b[m] < p[k]);
+        }
+        U[k] = U[k]*l + j;
+      }
+    } else
+      for (long k = 0; k < Ng; ++k) {
+        if (k == 0 || p[k] != p[k - 1])
+          j = std::lower_bound(a.begin(), a.end(), p[k]) - a.begin();
+        U[k] = U[k]*l + j;
+      }
+
+    N *= l;
+  }
+
+  return N;
+}
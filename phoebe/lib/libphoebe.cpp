@@ -33,6 +33,7 @@
 */
 
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <typeinfo>
 #include <algorithm>
@@ -56,7 +57,9 @@
 #include "misaligned_roche.h"      // support for gen. Roche lobes with missaligned angular momenta
 
 #include "wd_atm.h"                // Wilson-Devinney atmospheres
+#include "wd_mesh.h"               // Wilson-Devinney style discretization
 #include "interpolation.h"         // Nulti-dimensional linear interpolation
+#include "ld_models.h"             // Limb darkening models
 
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 
@@ -161,11 +164,11 @@ TNullBuff null_buffer;
 std::ostream report_stream(&null_buffer);
 
 /*
-  Report error with or without Python exception
+  Report error with or without Python exception, by default TypeError
 */
-void raise_exception(const std::string & str){
+void raise_exception(const std::string & str, PyObject *type = PyExc_TypeError){
   if (verbosity_level >= 1) report_stream << str << std::endl;
-  PyErr_SetString(PyExc_TypeError, str.c_str());
+  PyErr_SetString(type, str.c_str());
 }
 
 /*
@@ -263,12 +266,113 @@ PyObject *PyArray_FromVector(int N, T *V){
 }
 
 
+/*
+  Reading numpy arrays into vectors.
+
+  The arrays may be of any of the usual integer or floating point types
+  and with any strides, e.g. triangles as int64 or columns sliced out of a
+  larger array. Elements are converted to T while copying, so no converted
+  or contiguous intermediate copy of the array is needed. Arrays of type T
+  that are C-contiguous are copied directly.
+*/
+
+template <typename T, typename S>
+void PyArray_ToVector_strided(PyArrayObject *oV, std::vector<T> & V){
+
+  npy_intp N = PyArray_DIM(oV, 0), s = PyArray_STRIDE(oV, 0);
+
+  char *p = PyArray_BYTES(oV);
+
+  V.clear();
+  V.reserve(N);
+
+  for (npy_intp i = 0; i < N; ++i, p += s) V.push_back(T(*(S*)p));
+}
+
+template <typename T, typename S>
+void PyArray_To3DPointVector_strided(PyArrayObject *oV, std::vector<T3Dpoint<T>> & V){
+
+  npy_intp
+    N = PyArray_DIM(oV, 0),
+    s0 = PyArray_STRIDE(oV, 0),
+    s1 = PyArray_STRIDE(oV, 1);
+
+  char *p = PyArray_BYTES(oV);
+
+  V.reserve(N);
+
+  for (npy_intp i = 0; i < N; ++i, p += s0)
+    V.emplace_back(T(*(S*)p), T(*(S*)(p + s1)), T(*(S*)(p + 2*s1)));
+}
+
+template <typename T> bool PyArray_ToVector(PyArrayObject *oV, std::vector<T> & V);
+template <typename T> bool PyArray_To3DPointVector(PyArrayObject *oV, std::vector<T3Dpoint<T>> & V);
+
+/*
+  Reading arrays of any other type (e.g. int8, float16, long double) via
+  a copy converted to T by numpy. Returns false, with the Python exception
+  set by numpy, only if the array can not be converted to T at all.
+*/
+template <typename T>
+bool PyArray_ToVector_converted(PyArrayObject *oV, std::vector<T> & V){
+
+  PyArrayObject *oC = (PyArrayObject *)PyArray_FROM_OTF((PyObject *)oV, PyArray_TypeNum<T>(), NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+
+  if (!oC) return false;
+
+  bool ok = PyArray_ToVector(oC, V);
+
+  Py_DECREF(oC);
+
+  return ok;
+}
+
+template <typename T>
+bool PyArray_ToVector_converted(PyArrayObject *oV, std::vector<T3Dpoint<T>> & V){
+
+  PyArrayObject *oC = (PyArrayObject *)PyArray_FROM_OTF((PyObject *)oV, PyArray_TypeNum<T>(), NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+
+  if (!oC) return false;
+
+  bool ok = PyArray_To3DPointVector(oC, V);
+
+  Py_DECREF(oC);
+
+  return ok;
+}
+
+/*
+  Calling F<T, S>(oV, V) with S being the C++ type of the elements of
+  the numpy array oV. Arrays of other types are converted by numpy.
+*/
+#define PYARRAY_DISPATCH_TYPE(F, T, oV, V) \
+  switch (PyArray_TYPE(oV)) { \
+    case NPY_DOUBLE: F<T, double>(oV, V); break; \
+    case NPY_FLOAT: F<T, float>(oV, V); break; \
+    case NPY_INT: F<T, int>(oV, V); break; \
+    case NPY_UINT: F<T, unsigned int>(oV, V); break; \
+    case NPY_LONG: F<T, long>(oV, V); break; \
+    case NPY_ULONG: F<T, unsigned long>(oV, V); break; \
+    case NPY_LONGLONG: F<T, long long>(oV, V); break; \
+    case NPY_ULONGLONG: F<T, unsigned long long>(oV, V); break; \
+    case NPY_SHORT: F<T, short>(oV, V); break; \
+    case NPY_BOOL: F<T, npy_bool>(oV, V); break; \
+    default: return PyArray_ToVector_converted(oV, V); \
+  }
+
 template<typename T>
-void PyArray_ToVector(PyArrayObject *oV, std::vector<T> & V){
+bool PyArray_ToVector(PyArrayObject *oV, std::vector<T> & V){
+
+  if (PyArray_TYPE(oV) == PyArray_TypeNum<T>() && PyArray_IS_C_CONTIGUOUS(oV)) {
+    T *V_begin = (T*) PyArray_DATA(oV);
+
+    V.assign(V_begin, V_begin + PyArray_DIM(oV, 0));
+    return true;
+  }
 
-  T *V_begin = (T*) PyArray_DATA(oV);
+  PYARRAY_DISPATCH_TYPE(PyArray_ToVector_strided, T, oV, V)
 
-  V.assign(V_begin, V_begin + PyArray_DIM(oV, 0));
+  return true;
 }
 
 
@@ -298,17 +402,25 @@ PyObject *PyArray_From3DPointVector(std::vector<T3Dpoint<T>> &V){
 
 
 template <typename T>
-void PyArray_To3DPointVector(
+bool PyArray_To3DPointVector(
   PyArrayObject *oV,
   std::vector<T3Dpoint<T>> &V){
 
-  // Note: p is interpreted in C-style contiguous fashion
-  int N = PyArray_DIM(oV, 0);
+  if (PyArray_TYPE(oV) == PyArray_TypeNum<T>() && PyArray_IS_C_CONTIGUOUS(oV)) {
 
-  V.reserve(N);
+    int N = PyArray_DIM(oV, 0);
+
+    V.reserve(N);
 
-  for (T *p = (T*) PyArray_DATA(oV), *p_e = p + 3*N; p != p_e; p += 3)
-    V.emplace_back(p);
+    for (T *p = (T*) PyArray_DATA(oV), *p_e = p + 3*N; p != p_e; p += 3)
+      V.emplace_back(p);
+
+    return true;
+  }
+
+  PYARRAY_DISPATCH_TYPE(PyArray_To3DPointVector_strided, T, oV, V)
+
+  return true;
 }
 
 
@@ -2006,7 +2118,15 @@ static PyObject *roche_misaligned_critical_volume(PyObject *self, PyObject *args
   //
   double OmegaC, buf[3];
 
-  if (!misaligned_roche::critical_area_volume(2, q, F, d, theta, OmegaC, buf)){
+  bool ok;
+
+  Py_BEGIN_ALLOW_THREADS
+
+  ok = misaligned_roche::critical_area_volume(2, q, F, d, theta, OmegaC, buf);
+
+  Py_END_ALLOW_THREADS
+
+  if (!ok){
     raise_exception(fname + "::Calculation of critical volume failed");
     return NULL;
   }
@@ -2232,6 +2352,15 @@ static PyObject *roche_misaligned_area_volume(PyObject *self, PyObject *args, Py
     // calculation
     //
 
+    // report_stream is shared by all calls, so the diagnostics of the
+    // integration are collected while the GIL is released and written
+    // to it afterwards
+    std::ostringstream report;
+
+    report.copyfmt(report_stream);
+
+    Py_BEGIN_ALLOW_THREADS
+
     do {
 
       for (int i = 0, m = m0; i < 2; ++i, m <<= 1)
@@ -2243,7 +2372,7 @@ static PyObject *roche_misaligned_area_volume(PyObject *self, PyObject *args, Py
             (p[i], res_choice, pole, Omega0, q, F, d, theta, m);
 
           if (verbosity_level>=4)
-            report_stream << fname << "::m=" << m << " p[" << i  << "]=" << p[i][0] << ' ' << p[i][1] << '\n';
+            report << fname << "::m=" << m << " p[" << i  << "]=" << p[i][0] << ' ' << p[i][1] << '\n';
 
         }
 
@@ -2278,6 +2407,11 @@ static PyObject *roche_misaligned_area_volume(PyObject *self, PyObject *args, Py
         if (adjust) m0 = m0_next;
       }
     } while (adjust);
+
+    Py_END_ALLOW_THREADS
+
+    if (verbosity_level>=4)
+      report_stream << report.str();
   }
 
   PyObject *results = PyDict_New();
@@ -2798,9 +2932,18 @@ static PyObject *roche_misaligned_Omega_at_vol(PyObject *self, PyObject *args, P
   if (verbosity_level>=4)
     report_stream << fname << "::calculate critical volume ...\n";
 
+  bool ok = true;
+
+  Py_BEGIN_ALLOW_THREADS
+
   if (aligned)
     gen_roche::critical_area_volume(6, q, F, d, OmegaC, buf);
-  else if (!misaligned_roche::critical_area_volume(6, q, F, d, theta, OmegaC, buf)) {
+  else
+    ok = misaligned_roche::critical_area_volume(6, q, F, d, theta, OmegaC, buf);
+
+  Py_END_ALLOW_THREADS
+
+  if (!ok) {
     raise_exception(fname + ":: Calculation of critical_volume failed");
   }
 
@@ -2921,12 +3064,16 @@ static PyObject *roche_misaligned_Omega_at_vol(PyObject *self, PyObject *args, P
     do {
 
       // calculate volume and derivate volume w.r.t to Omega
+      Py_BEGIN_ALLOW_THREADS
+
       for (int i = 0, m = m0; i < 2; ++i, m <<= 1)
         if (aligned)
           gen_roche::area_volume_integration(p[i]-1, 6, xrange, Omega, q, F, d, m);
         else
           misaligned_roche::area_volume_integration(p[i]-1, 6, pole, Omega, q, F, d, theta, m);
 
+      Py_END_ALLOW_THREADS
+
 
       if (adjust) {
 
@@ -4091,6 +4238,10 @@ static PyObject *roche_misaligned_Omega(PyObject *self, PyObject *args) {
       cnormals: boolean, default False
       cnormgrads: boolean, default False
       init_phi: float, default 0
+      reorder: boolean, default False
+      use_hessian: boolean, default False
+        use the Hessian in projections and predictions of new vertices
+        (fewer gradient evaluations, but a slightly different mesh)
 
   Returns:
 
@@ -4133,6 +4284,14 @@ static PyObject *roche_misaligned_Omega(PyObject *self, PyObject *args) {
     cnormgrads:
       GatC[]      - 1-rank numpy array of norms of the gradients at central points
 
+    vperm: if reorder
+      Pv[]        - 1-rank numpy array of the permutation of vertices
+                    along the Morton (Z-order) curve: V[i] = V_orig[Pv[i]]
+
+    tperm: if reorder
+      Pt[]        - 1-rank numpy array of the permutation of triangles
+                    following the order of their vertices
+
 
   Typically face-vertex format is (V, T) where
 
@@ -4179,6 +4338,8 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
     (char*)"area",
     (char*)"volume",
     (char*)"init_phi",
+    (char*)"reorder",
+    (char*)"use_hessian",
     NULL};
 
   double q, F, d, Omega0, delta,
@@ -4199,7 +4360,9 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
     b_cnormgrads = false,
     b_areas = false,
     b_area = false,
-    b_volume = false;
+    b_volume = false,
+    b_reorder = false,
+    b_use_hessian = false;
 
   // http://wingware.com/psupport/python-manual/2.3/api/boolObjects.html
   PyObject
@@ -4214,10 +4377,12 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
     *o_cnormgrads = 0,
     *o_areas = 0,
     *o_area = 0,
-    *o_volume = 0;
+    *o_volume = 0,
+    *o_reorder = 0,
+    *o_use_hessian = 0;
 
   if (!PyArg_ParseTupleAndKeywords(
-      args, keywds,  "ddddd|iiO!O!O!O!O!O!O!O!O!O!O!O!d", kwlist,
+      args, keywds,  "ddddd|iiO!O!O!O!O!O!O!O!O!O!O!O!dO!O!", kwlist,
       &q, &F, &d, &Omega0, &delta, // neccesary
       &choice,                     // optional ...
       &max_triangles,
@@ -4233,7 +4398,9 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
       &PyBool_Type, &o_areas,
       &PyBool_Type, &o_area,
       &PyBool_Type, &o_volume,
-      &init_phi
+      &init_phi,
+      &PyBool_Type, &o_reorder,
+      &PyBool_Type, &o_use_hessian
       )) {
 
     raise_exception(fname + "::Problem reading arguments");
@@ -4252,6 +4419,8 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
   if (o_areas) b_areas = PyObject_IsTrue(o_areas);
   if (o_area) b_area = PyObject_IsTrue(o_area);
   if (o_volume) b_volume = PyObject_IsTrue(o_volume);
+  if (o_reorder) b_reorder = PyObject_IsTrue(o_reorder);
+  if (o_use_hessian) b_use_hessian = PyObject_IsTrue(o_use_hessian);
 
   //
   // Storing results in dictioonary
@@ -4296,18 +4465,26 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
 
   Tmarching<double, Tgen_roche<double>> march(params);
 
+  march.use_hessian = b_use_hessian;
+
   std::vector<T3Dpoint<double>> V, NatV;
   std::vector<T3Dpoint<int>> Tr;
   std::vector<double> *GatV = 0;
 
   if (b_vnormgrads) GatV = new std::vector<double>;
 
-  int error =
+  int error;
+
+  Py_BEGIN_ALLOW_THREADS
+
+  error =
     (b_full ?
       march.triangulize_full_clever(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi) :
       march.triangulize(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi)
     );
 
+  Py_END_ALLOW_THREADS
+
   switch(error) {
     case 1:
       raise_exception("There are too many triangles!");
@@ -4317,6 +4494,16 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
       return NULL;
   }
 
+  //
+  // Reorder the mesh along the space-filling curve
+  //
+
+  std::vector<int> Pv, Pt;
+
+  if (b_reorder) {
+    mesh_reorder_morton(V, NatV, Tr, GatV, &Pv, &Pt);
+  }
+
   if (verbosity_level >=4)
     report_stream << fname
       << "::V.size=" << V.size()
@@ -4360,8 +4547,18 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
   if (b_cnormgrads) GatC = new std::vector<double>;
 
 
+  Py_BEGIN_ALLOW_THREADS
+
   march.central_points(V, Tr, C, NatC, GatC);
 
+  Py_END_ALLOW_THREADS
+
+  if (verbosity_level>=4)
+    report_stream << fname
+      << "::projections=" << march.nr_proj
+      << " gradients=" << march.nr_grad
+      << " hessians=" << march.nr_hess << '\n';
+
 
   if (b_vertices)
     PyDict_SetItemStringStealRef(results, "vertices", PyArray_From3DPointVector(V));
@@ -4408,6 +4605,11 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
     delete GatC;
   }
 
+  if (b_reorder) {
+    PyDict_SetItemStringStealRef(results, "vperm", PyArray_FromVector(Pv));
+    PyDict_SetItemStringStealRef(results, "tperm", PyArray_FromVector(Pt));
+  }
+
   return results;
 }
 
@@ -4454,6 +4656,11 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
         orientation of the initial polygon front
       init_dir: 1-rank numpy array of floats = [theta, phi], default [0,0]
         direction of the initial point in marching given by spherical angles
+      reorder: boolean, default False
+        reorder the mesh along the Morton (Z-order) space-filling curve
+      use_hessian: boolean, default False
+        use the Hessian in projections and predictions of new vertices
+        (fewer gradient evaluations, but a slightly different mesh)
 
   Returns:
 
@@ -4496,6 +4703,14 @@ static PyObject *roche_marching_mesh(PyObject *self, PyObject *args, PyObject *k
     cnormgrads:
       GatC[]      - 1-rank numpy array of norms of the gradients at central points
 
+    vperm: if reorder
+      Pv[]        - 1-rank numpy array of the permutation of vertices
+                    along the Morton (Z-order) curve: V[i] = V_orig[Pv[i]]
+
+    tperm: if reorder
+      Pt[]        - 1-rank numpy array of the permutation of triangles
+                    following the order of their vertices
+
 
   Typically face-vertex format is (V, T) where
 
@@ -4542,6 +4757,8 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
     (char*)"volume",
     (char*)"init_phi",
     (char*)"init_dir",
+    (char*)"reorder",
+    (char*)"use_hessian",
     NULL};
 
   double omega, Omega0, delta,
@@ -4561,7 +4778,9 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
     b_cnormgrads = false,
     b_areas = false,
     b_area = false,
-    b_volume = false;
+    b_volume = false,
+    b_reorder = false,
+    b_use_hessian = false;
 
   // http://wingware.com/psupport/python-manual/2.3/api/boolObjects.html
   PyObject
@@ -4576,12 +4795,14 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
     *o_cnormgrads = 0,
     *o_areas = 0,
     *o_area = 0,
-    *o_volume = 0;
+    *o_volume = 0,
+    *o_reorder = 0,
+    *o_use_hessian = 0;
 
   PyArrayObject *o_init_dir = 0;
 
   if (!PyArg_ParseTupleAndKeywords(
-      args, keywds,  "ddd|iO!O!O!O!O!O!O!O!O!O!O!O!dO!", kwlist,
+      args, keywds,  "ddd|iO!O!O!O!O!O!O!O!O!O!O!O!dO!O!O!", kwlist,
       &omega, &Omega0, &delta, // neccesary
       &max_triangles,
       &PyBool_Type, &o_full,
@@ -4597,7 +4818,9 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
       &PyBool_Type, &o_area,
       &PyBool_Type, &o_volume,
       &init_phi,
-      &PyArray_Type, &o_init_dir)
+      &PyArray_Type, &o_init_dir,
+      &PyBool_Type, &o_reorder,
+      &PyBool_Type, &o_use_hessian)
   ){
     raise_exception(fname + "::Problem reading arguments");
     return NULL;
@@ -4618,6 +4841,8 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
   if (o_areas) b_areas = PyObject_IsTrue(o_areas);
   if (o_area) b_area = PyObject_IsTrue(o_area);
   if (o_volume) b_volume = PyObject_IsTrue(o_volume);
+  if (o_reorder) b_reorder = PyObject_IsTrue(o_reorder);
+  if (o_use_hessian) b_use_hessian = PyObject_IsTrue(o_use_hessian);
   if (o_init_dir) {
     double *p = (double*)PyArray_DATA(o_init_dir);
     init_dir[0] = p[0];
@@ -4667,18 +4892,26 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
 
   Tmarching<double, Trot_star<double>> march(params);
 
+  march.use_hessian = b_use_hessian;
+
   std::vector<T3Dpoint<double>> V, NatV;
   std::vector<T3Dpoint<int>> Tr;
   std::vector<double> *GatV = 0;
 
   if (b_vnormgrads) GatV = new std::vector<double>;
 
-  int error =
+  int error;
+
+  Py_BEGIN_ALLOW_THREADS
+
+  error =
     (b_full ?
       march.triangulize_full_clever(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi) :
       march.triangulize(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi)
     );
 
+  Py_END_ALLOW_THREADS
+
   switch(error) {
     case 1:
       raise_exception("There are too many triangles!");
@@ -4688,6 +4921,16 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
       return NULL;
   }
 
+  //
+  // Reorder the mesh along the space-filling curve
+  //
+
+  std::vector<int> Pv, Pt;
+
+  if (b_reorder) {
+    mesh_reorder_morton(V, NatV, Tr, GatV, &Pv, &Pt);
+  }
+
   if (verbosity_level >= 4)
     report_stream << fname << "::Outputing" << std::endl;
 
@@ -4729,8 +4972,18 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
 
   if (b_cnormgrads) GatC = new std::vector<double>;
 
+  Py_BEGIN_ALLOW_THREADS
+
   march.central_points(V, Tr, C, NatC, GatC);
 
+  Py_END_ALLOW_THREADS
+
+  if (verbosity_level>=4)
+    report_stream << fname
+      << "::projections=" << march.nr_proj
+      << " gradients=" << march.nr_grad
+      << " hessians=" << march.nr_hess << '\n';
+
   //
   // Returning results
   //
@@ -4785,6 +5038,11 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
   if (verbosity_level>=4)
     report_stream << fname << "::END\n";
 
+  if (b_reorder) {
+    PyDict_SetItemStringStealRef(results, "vperm", PyArray_FromVector(Pv));
+    PyDict_SetItemStringStealRef(results, "tperm", PyArray_FromVector(Pt));
+  }
+
   return results;
 }
 
@@ -4848,6 +5106,11 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
         orientation of the initial polygon front
       init_dir: 1-rank numpy array of floats = [theta, phi], default [0,0]
         direction of the initial point in marching given by spherical angles
+      reorder: boolean, default False
+        reorder the mesh along the Morton (Z-order) space-filling curve
+      use_hessian: boolean, default False
+        use the Hessian in projections and predictions of new vertices
+        (fewer gradient evaluations, but a slightly different mesh)
 
   Returns:
 
@@ -4890,6 +5153,14 @@ static PyObject *rotstar_marching_mesh(PyObject *self, PyObject *args, PyObject
     cnormgrads:
       GatC[]      - 1-rank numpy array of norms of the gradients at central points
 
+    vperm: if reorder
+      Pv[]        - 1-rank numpy array of the permutation of vertices
+                    along the Morton (Z-order) curve: V[i] = V_orig[Pv[i]]
+
+    tperm: if reorder
+      Pt[]        - 1-rank numpy array of the permutation of triangles
+                    following the order of their vertices
+
 
   Typically face-vertex format is (V, T) where
 
@@ -4937,6 +5208,8 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
     (char*)"volume",
     (char*)"init_phi",
     (char*)"init_dir",
+    (char*)"reorder",
+    (char*)"use_hessian",
     NULL};
 
   double omega, Omega0, delta,
@@ -4956,7 +5229,9 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
     b_cnormgrads = false,
     b_areas = false,
     b_area = false,
-    b_volume = false;
+    b_volume = false,
+    b_reorder = false,
+    b_use_hessian = false;
 
   // http://wingware.com/psupport/python-manual/2.3/api/boolObjects.html
   PyObject
@@ -4971,14 +5246,16 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
     *o_cnormgrads = 0,
     *o_areas = 0,
     *o_area = 0,
-    *o_volume = 0;
+    *o_volume = 0,
+    *o_reorder = 0,
+    *o_use_hessian = 0;
 
   PyObject *o_misalignment;
 
   PyArrayObject *o_init_dir = 0;
 
   if (!PyArg_ParseTupleAndKeywords(
-      args, keywds,  "dOdd|iO!O!O!O!O!O!O!O!O!O!O!O!dO!", kwlist,
+      args, keywds,  "dOdd|iO!O!O!O!O!O!O!O!O!O!O!O!dO!O!O!", kwlist,
       &omega, &o_misalignment, &Omega0, &delta, // neccesary
       &max_triangles,
       &PyBool_Type, &o_full,
@@ -4994,7 +5271,9 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
       &PyBool_Type, &o_area,
       &PyBool_Type, &o_volume,
       &init_phi,
-      &PyArray_Type, &o_init_dir)
+      &PyArray_Type, &o_init_dir,
+      &PyBool_Type, &o_reorder,
+      &PyBool_Type, &o_use_hessian)
   ){
     raise_exception(fname + "::Problem reading arguments");
     return NULL;
@@ -5012,6 +5291,8 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
   if (o_areas) b_areas = PyObject_IsTrue(o_areas);
   if (o_area) b_area = PyObject_IsTrue(o_area);
   if (o_volume) b_volume = PyObject_IsTrue(o_volume);
+  if (o_reorder) b_reorder = PyObject_IsTrue(o_reorder);
+  if (o_use_hessian) b_use_hessian = PyObject_IsTrue(o_use_hessian);
   if (o_init_dir) {
     double *p = (double*)PyArray_DATA(o_init_dir);
     init_dir[0] = p[0];
@@ -5071,6 +5352,8 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
 
   Tmarching<double, Tmisaligned_rot_star<double>> march(params);
 
+  march.use_hessian = b_use_hessian;
+
   std::vector<T3Dpoint<double>> V, NatV;
   std::vector<T3Dpoint<int>> Tr;
   std::vector<double> *GatV = 0;
@@ -5078,11 +5361,17 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
   if (b_vnormgrads) GatV = new std::vector<double>;
 
 
-  int error =(b_full ?
+  int error;
+
+  Py_BEGIN_ALLOW_THREADS
+
+  error =(b_full ?
       march.triangulize_full_clever(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi):
       march.triangulize(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi)
       );
 
+  Py_END_ALLOW_THREADS
+
   switch(error) {
     case 1:
       raise_exception("There are too many triangles!");
@@ -5092,6 +5381,16 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
       return NULL;
   }
 
+  //
+  // Reorder the mesh along the space-filling curve
+  //
+
+  std::vector<int> Pv, Pt;
+
+  if (b_reorder) {
+    mesh_reorder_morton(V, NatV, Tr, GatV, &Pv, &Pt);
+  }
+
   //
   // Calculate the mesh properties
   //
@@ -5130,8 +5429,18 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
 
   if (b_cnormgrads) GatC = new std::vector<double>;
 
+  Py_BEGIN_ALLOW_THREADS
+
   march.central_points(V, Tr, C, NatC, GatC);
 
+  Py_END_ALLOW_THREADS
+
+  if (verbosity_level>=4)
+    report_stream << fname
+      << "::projections=" << march.nr_proj
+      << " gradients=" << march.nr_grad
+      << " hessians=" << march.nr_hess << '\n';
+
   //
   // Returning results
   //
@@ -5186,6 +5495,11 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
   if (verbosity_level>=4)
     report_stream << fname << "::END" << std::endl;
 
+  if (b_reorder) {
+    PyDict_SetItemStringStealRef(results, "vperm", PyArray_FromVector(Pv));
+    PyDict_SetItemStringStealRef(results, "tperm", PyArray_FromVector(Pt));
+  }
+
   return results;
 }
 
@@ -5235,6 +5549,7 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
       cnormals: boolean, default False
       cnormgrads: boolean, default False
       init_phi: float, default 0
+      reorder: boolean, default False
 
   Returns:
 
@@ -5277,6 +5592,14 @@ static PyObject *rotstar_misaligned_marching_mesh(PyObject *self, PyObject *args
     cnormgrads:
       GatC[]      - 1-rank numpy array of norms of the gradients at central points
 
+    vperm: if reorder
+      Pv[]        - 1-rank numpy array of the permutation of vertices
+                    along the Morton (Z-order) curve: V[i] = V_orig[Pv[i]]
+
+    tperm: if reorder
+      Pt[]        - 1-rank numpy array of the permutation of triangles
+                    following the order of their vertices
+
 
   Typically face-vertex format is (V, T) where
 
@@ -5318,6 +5641,7 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
     (char*)"area",
     (char*)"volume",
     (char*)"init_phi",
+    (char*)"reorder",
     NULL};
 
   double Omega0, delta,
@@ -5337,7 +5661,8 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
     b_cnormgrads = false,
     b_areas = false,
     b_area = false,
-    b_volume = false;
+    b_volume = false,
+    b_reorder = false;
 
   // http://wingware.com/psupport/python-manual/2.3/api/boolObjects.html
   PyObject
@@ -5352,10 +5677,11 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
     *o_cnormgrads = 0,
     *o_areas = 0,
     *o_area = 0,
-    *o_volume = 0;
+    *o_volume = 0,
+    *o_reorder = 0;
 
   if (!PyArg_ParseTupleAndKeywords(
-      args, keywds,  "dd|iO!O!O!O!O!O!O!O!O!O!O!O!d", kwlist,
+      args, keywds,  "dd|iO!O!O!O!O!O!O!O!O!O!O!O!dO!", kwlist,
       &Omega0, &delta,                  // neccesary
       &max_triangles,                   // optional ...
       &PyBool_Type, &o_full,
@@ -5370,7 +5696,8 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
       &PyBool_Type, &o_areas,
       &PyBool_Type, &o_area,
       &PyBool_Type, &o_volume,
-      &init_phi
+      &init_phi,
+      &PyBool_Type, &o_reorder
       )) {
     raise_exception(fname + "::Problem reading arguments");
     return NULL;
@@ -5388,6 +5715,7 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
   if (o_areas) b_areas = PyObject_IsTrue(o_areas);
   if (o_area) b_area = PyObject_IsTrue(o_area);
   if (o_volume) b_volume = PyObject_IsTrue(o_volume);
+  if (o_reorder) b_reorder = PyObject_IsTrue(o_reorder);
 
   //
   // Storing results in dictioonary
@@ -5412,12 +5740,18 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
   std::vector<T3Dpoint<int>> Tr;
   std::vector<double> *GatV = 0;
 
-  int error =
+  int error;
+
+  Py_BEGIN_ALLOW_THREADS
+
+  error =
     (b_full ?
       march.triangulize_full_clever(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi) :
       march.triangulize(r, g, delta, max_triangles, V, NatV, Tr, GatV, init_phi)
     );
 
+  Py_END_ALLOW_THREADS
+
   switch(error) {
     case 1:
       raise_exception("There are too many triangles!");
@@ -5427,6 +5761,16 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
       return NULL;
   }
 
+  //
+  // Reorder the mesh along the space-filling curve
+  //
+
+  std::vector<int> Pv, Pt;
+
+  if (b_reorder) {
+    mesh_reorder_morton(V, NatV, Tr, GatV, &Pv, &Pt);
+  }
+
   if (b_vnormgrads)
     GatV = new std::vector<double>(V.size(), Omega0*Omega0);
 
@@ -5552,6 +5896,11 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
     delete GatC;
   }
 
+  if (b_reorder) {
+    PyDict_SetItemStringStealRef(results, "vperm", PyArray_FromVector(Pv));
+    PyDict_SetItemStringStealRef(results, "tperm", PyArray_FromVector(Pt));
+  }
+
   return results;
 }
 
@@ -5617,6 +5966,7 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
       cnormals: boolean, default False
       cnormgrads: boolean, default False
       init_phi: float, default 0
+      reorder: boolean, default False
 
   Returns:
 
@@ -5659,6 +6009,14 @@ static PyObject *sphere_marching_mesh(PyObject *self, PyObject *args, PyObject *
     cnormgrads:
       GatC[]      - 1-rank numpy array of norms of the gradients at central points
 
+    vperm: if reorder
+      Pv[]        - 1-rank numpy array of the permutation of vertices
+                    along the Morton (Z-order) curve: V[i] = V_orig[Pv[i]]
+
+    tperm: if reorder
+      Pt[]        - 1-rank numpy array of the permutation of triangles
+                    following the order of their vertices
+
 
   Typically face-vertex format is (V, T) where
 
@@ -5708,6 +6066,7 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
     (char*)"area",
     (char*)"volume",
     (char*)"init_phi",
+    (char*)"reorder",
     NULL};
 
   PyObject *o_misalignment;
@@ -5732,7 +6091,8 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
     b_cnormgrads = false,
     b_areas = false,
     b_area = false,
-    b_volume = false;
+    b_volume = false,
+    b_reorder = false;
 
   // http://wingware.com/psupport/python-manual/2.3/api/boolObjects.html
   PyObject
@@ -5747,10 +6107,11 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
     *o_cnormgrads = 0,
     *o_areas = 0,
     *o_area = 0,
-    *o_volume = 0;
+    *o_volume = 0,
+    *o_reorder = 0;
 
   if (!PyArg_ParseTupleAndKeywords(
-        args, keywds,  "dddOdd|iiO!O!O!O!O!O!O!O!O!O!O!O!d", kwlist,
+        args, keywds,  "dddOdd|iiO!O!O!O!O!O!O!O!O!O!O!O!dO!", kwlist,
         &q, &F, &d, &o_misalignment, &Omega0, &delta,  // neccesary
         &choice,                              // optional ...
         &max_triangles,
@@ -5766,7 +6127,8 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
         &PyBool_Type, &o_areas,
         &PyBool_Type, &o_area,
         &PyBool_Type, &o_volume,
-        &init_phi
+        &init_phi,
+        &PyBool_Type, &o_reorder
       )) {
 
     raise_exception(fname + "::Problem reading arguments");
@@ -5785,6 +6147,7 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
   if (o_areas) b_areas = PyObject_IsTrue(o_areas);
   if (o_area) b_area = PyObject_IsTrue(o_area);
   if (o_volume) b_volume = PyObject_IsTrue(o_volume);
+  if (o_reorder) b_reorder = PyObject_IsTrue(o_reorder);
 
   //
   // Storing results in dictioonary
@@ -5865,6 +6228,8 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
 
   int error = 0;
 
+  Py_BEGIN_ALLOW_THREADS
+
   if (aligned) {
     double params[] = {q, F, d, Omega0};
 
@@ -5906,6 +6271,8 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
     }
   }
 
+  Py_END_ALLOW_THREADS
+
 
   if (error && verbosity_level>=2) {
     report_stream << fname
@@ -5932,6 +6299,21 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
       return NULL;
   }
 
+  //
+  // Reorder the mesh along the space-filling curve
+  //
+
+  std::vector<int> Pv, Pt;
+
+  if (b_reorder) {
+    mesh_reorder_morton(V, NatV, Tr, GatV, &Pv, &Pt);
+
+    // central points were already calculated
+    if (C) mesh_permute(*C, Pt);
+    if (NatC) mesh_permute(*NatC, Pt);
+    if (GatC) mesh_permute(*GatC, Pt);
+  }
+
   if (verbosity_level>=4)
     report_stream << fname << "::V.size=" << V.size() << " Tr.size=" << Tr.size() << '\n';
 
@@ -6007,6 +6389,127 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
   if (verbosity_level>=4)
     report_stream << fname << "::END" << std::endl;
 
+  if (b_reorder) {
+    PyDict_SetItemStringStealRef(results, "vperm", PyArray_FromVector(Pv));
+    PyDict_SetItemStringStealRef(results, "tperm", PyArray_FromVector(Pt));
+  }
+
+  return results;
+}
+
+/*
+  C++ wrapper for Python code:
+
+  Discretize the primary (left) generalized Roche lobe in the style of
+  the Wilson-Devinney code.
+
+  Python:
+
+    dict = roche_wd_mesh(q, F, d, Omega0, N)
+
+  where parameters are
+
+  positionals:
+    q: float = M2/M1 - mass ratio
+    F: float - synchronicity parameter
+    d: float - separation between the two objects
+    Omega0: float - value of the generalized Kopal potential
+    N: integer - number of rings in colatitude from the pole to the equator
+
+  Returns:
+
+    dictionary
+
+  with keywords
+
+    table:
+      G[][19] - 2-rank numpy array of triangles with columns
+
+        0-2: center of the element
+        3: half of the WD area of the element
+        4-12: vertices of the triangle
+        13-15: normal at the center of the element (-grad Omega)
+        16: colatitude theta of the ring
+        17: longitude phi of the first element in the ring
+        18: area of the triangle r1, r2, r3 of the element
+
+    nfailed:
+      number of projections onto the surface that did not converge
+*/
+
+static PyObject *roche_wd_mesh(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "roche_wd_mesh"_s;
+
+  //
+  // Reading arguments
+  //
+
+  char *kwlist[] = {
+    (char*)"q",
+    (char*)"F",
+    (char*)"d",
+    (char*)"Omega0",
+    (char*)"N",
+    NULL};
+
+  double q, F, d, Omega0;
+
+  int N;
+
+  if (!PyArg_ParseTupleAndKeywords(
+      args, keywds,  "ddddi", kwlist, &q, &F, &d, &Omega0, &N)){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  if (N < 1) {
+    raise_exception(fname + "::N needs to be positive");
+    return NULL;
+  }
+
+  //
+  // Discretizing the lobe
+  //
+
+  double
+    params[4] = {q, F, d, Omega0},
+    r0 = gen_roche::poleL(Omega0, q, F, d);
+
+  Tgen_roche<double> body(params);
+
+  std::vector<double> G;
+
+  int nfailed;
+
+  Py_BEGIN_ALLOW_THREADS
+  nfailed = wd_mesh::discretize(body, r0, N, G);
+  Py_END_ALLOW_THREADS
+
+  if (verbosity_level>=4)
+    report_stream << fname << "::N=" << N << " nfailed=" << nfailed << std::endl;
+
+  //
+  // Returning results
+  //
+
+  npy_intp dims[2] = {npy_intp(G.size()/wd_mesh::ncols), wd_mesh::ncols};
+
+  #if defined(USING_SimpleNewFromData)
+  double *p = (double*) PyObject_Malloc(G.size()*sizeof(double));
+  std::copy(G.begin(), G.end(), p);
+  PyObject *oG = PyArray_SimpleNewFromData(2, dims, NPY_DOUBLE, p);
+  PyArray_ENABLEFLAGS((PyArrayObject *)oG, NPY_ARRAY_OWNDATA);
+  #else
+  PyObject *oG = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+  std::copy(G.begin(), G.end(), (double*)PyArray_DATA((PyArrayObject *)oG));
+  #endif
+
+  PyObject *results = PyDict_New();
+
+  PyDict_SetItemStringStealRef(results, "table", oG);
+  PyDict_SetItemStringStealRef(results, "nfailed", PyInt_FromLong(nfailed));
+
   return results;
 }
 
@@ -6034,6 +6537,8 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
     tvisibilities: boolean, default True
     taweights: boolean, default False
     horizon: boolean, default False
+    cut_stats: boolean, default False (only for linear method, raises
+      an exception otherwise)
 
   Returns: dictionary with keywords
 
@@ -6048,6 +6553,10 @@ static PyObject *roche_misaligned_marching_mesh(PyObject *self, PyObject *args,
 
     Note: They are not sorted in depth, as in principle they can not be!
 
+    cut_stats: statistics of cutting triangles along the mu=0 horizon
+      C[4] - 1-rank numpy array of numbers of triangles that are
+        back-facing, forward-facing, cut to triangles, cut to quadrilaterals
+
   Ref:
   * http://docs.scipy.org/doc/numpy-1.10.1/reference/arrays.ndarray.html
   * http://docs.scipy.org/doc/numpy/reference/c-api.array.html#creating-arrays
@@ -6071,6 +6580,7 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
     (char*)"tvisibilities",
     (char*)"taweights",
     (char*)"horizon",
+    (char*)"cut_stats",
     NULL};
 
   PyArrayObject *ov = 0, *oV = 0, *oT = 0, *oN = 0;
@@ -6079,16 +6589,18 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
     *o_method,
     *o_tvisibilities = 0,
     *o_taweights = 0,
-    *o_horizon = 0;
+    *o_horizon = 0,
+    *o_cut_stats = 0;
 
   bool
     b_tvisibilities = true,
     b_taweights = false,
-    b_horizon = false;
+    b_horizon = false,
+    b_cut_stats = false;
 
   // parse arguments
   if (!PyArg_ParseTupleAndKeywords(
-        args, keywds, "O!O!O!O!O!|O!O!O!", kwlist,
+        args, keywds, "O!O!O!O!O!|O!O!O!O!", kwlist,
         &PyArray_Type, &ov,
         &PyArray_Type, &oV,
         &PyArray_Type, &oT,
@@ -6096,7 +6608,8 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
         &PyString_Type, &o_method,
         &PyBool_Type, &o_tvisibilities,
         &PyBool_Type, &o_taweights,
-        &PyBool_Type, &o_horizon
+        &PyBool_Type, &o_horizon,
+        &PyBool_Type, &o_cut_stats
         )
       ){
     raise_exception(fname + "::Problem reading arguments");
@@ -6107,27 +6620,33 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
   if (o_taweights) b_taweights = PyObject_IsTrue(o_taweights);
   if (o_horizon) b_horizon = PyObject_IsTrue(o_horizon);
 
-  if (!b_tvisibilities && !b_taweights && !b_horizon) return NULL;
+  if (o_cut_stats) b_cut_stats = PyObject_IsTrue(o_cut_stats);
+
+  if (!b_tvisibilities && !b_taweights && !b_horizon && !b_cut_stats) return NULL;
 
-  if (!PyArray_ISCONTIGUOUS(ov)||
-      !PyArray_ISCONTIGUOUS(oV)||
-      !PyArray_ISCONTIGUOUS(oT)||
-      !PyArray_ISCONTIGUOUS(oN)) {
+  if (b_cut_stats && fnv1a_32::hash(PyString_AsString(o_method)) != "linear"_hash32) {
+    raise_exception(fname + "::cut_stats are only available for the linear method");
+    return NULL;
+  }
 
-    raise_exception(fname + "::Input numpy arrays are not C-contiguous");
+  if (!PyArray_ISCONTIGUOUS(ov) || PyArray_TYPE(ov) != NPY_DOUBLE) {
+    raise_exception(fname + "::Viewing direction is not a C-contiguous array of floats");
     return NULL;
   }
 
   double *view = (double*)PyArray_DATA(ov);
 
+  // V, T and N can be of any strides and numerical type
   std::vector<T3Dpoint<double> > V;
-  PyArray_To3DPointVector(oV, V);
-
   std::vector<T3Dpoint<int>> T;
-  PyArray_To3DPointVector(oT, T);
-
   std::vector<T3Dpoint<double> > N;
-  PyArray_To3DPointVector(oN, N);
+
+  if (!PyArray_To3DPointVector(oV, V) ||
+      !PyArray_To3DPointVector(oT, T) ||
+      !PyArray_To3DPointVector(oN, N)) {
+    raise_exception(fname + "::Input numpy arrays could not be converted");
+    return NULL;
+  }
 
   std::vector<double> *M = 0;
   if (b_tvisibilities) M = new std::vector<double>;
@@ -6138,13 +6657,21 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
   std::vector<std::vector<int>> *H = 0;
   if (b_horizon) H = new std::vector<std::vector<int>>;
 
+  std::vector<int> C(4, 0);
+
   //
   //  Calculate visibility
   //
   {
     char *s = PyString_AsString(o_method);
 
-    switch (fnv1a_32::hash(s)) {
+    auto method = fnv1a_32::hash(s);
+
+    // the mesh is copied into C++ containers, so other python threads
+    // (e.g. meshing the next epoch) can run in the meantime
+    Py_BEGIN_ALLOW_THREADS
+
+    switch (method) {
 
       case "boolean"_hash32:
         // N - normal of traingles
@@ -6153,9 +6680,11 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
 
       case "linear"_hash32:
         // N - normals at vertices
-        triangle_mesh_visibility_linear(view, V, T, N, M, W, H);
+        triangle_mesh_visibility_linear(view, V, T, N, M, W, H, b_cut_stats ? C.data() : 0);
         break;
     }
+
+    Py_END_ALLOW_THREADS
   }
   //
   // Storing results in dictionary
@@ -6184,6 +6713,9 @@ static PyObject *mesh_visibility(PyObject *self, PyObject *args, PyObject *keywd
     delete H;
   }
 
+  if (b_cut_stats)
+    PyDict_SetItemStringStealRef(results, "cut_stats", PyArray_FromVector(C));
+
   return results;
 }
 
@@ -6610,6 +7142,124 @@ static PyObject *mesh_properties(PyObject *self, PyObject *args, PyObject *keywd
   return results;
 }
 
+/*
+  C++ wrapper for Python code:
+
+  Split the triangular mesh by the plane x = xmin (ie. the neck of the
+  contact envelope) and calculate fractional areas of triangles crossing
+  the plane.
+
+  Python:
+
+    dict = mesh_split_by_plane(V, T, xmin)
+
+  where positional parameters
+
+    V[][3]: 2-rank numpy array of vertices
+    T[][3]: 2-rank numpy array of 3 indices of vertices
+            composing triangles of the mesh aka connectivity matrix
+    xmin: float - position of the plane
+
+  Returns:
+
+    dictionary
+
+  with keywords
+
+    frac_areas:
+      F[][3] - 2-rank numpy array of fractional areas at vertices of
+               triangles: the lone vertex of a crossing triangle gets the
+               part of the triangle on its side of the plane and the other
+               two vertices half of the rest each, all others are 1
+
+    vcomp:
+      Cv[] - 1-rank numpy array of components of vertices (0 for x <= xmin
+             and 1 for x > xmin)
+
+    tcomp:
+      Ct[] - 1-rank numpy array of components of triangles based on their
+             centroids
+
+    ncrossing:
+      Nc - number of triangles crossing the plane
+*/
+
+static PyObject *mesh_split_by_plane(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "mesh_split_by_plane"_s;
+
+  //
+  // Reading arguments
+  //
+
+  char *kwlist[] = {
+    (char*)"V",
+    (char*)"T",
+    (char*)"xmin",
+    NULL};
+
+  PyArrayObject *oV, *oT;
+
+  double xmin;
+
+  if (!PyArg_ParseTupleAndKeywords(
+      args, keywds,  "O!O!d", kwlist,
+      &PyArray_Type, &oV,
+      &PyArray_Type, &oT,
+      &xmin
+      )){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  std::vector<T3Dpoint<double>> V;
+  std::vector<T3Dpoint<int>> Tr;
+
+  if (!PyArray_To3DPointVector(oV, V) || !PyArray_To3DPointVector(oT, Tr)) {
+    raise_exception(fname + "::Input numpy arrays could not be converted");
+    return NULL;
+  }
+
+  int Nv = V.size();
+
+  for (auto && t : Tr)
+    for (int i = 0; i < 3; ++i)
+      if (t[i] < 0 || t[i] >= Nv) {
+        raise_exception(fname + "::Index of vertex out of range");
+        return NULL;
+      }
+
+  //
+  // Splitting the mesh
+  //
+
+  int Nc;
+
+  std::vector<T3Dpoint<double>> F;
+
+  std::vector<int> Cv, Ct;
+
+  Py_BEGIN_ALLOW_THREADS
+  Nc = mesh_split_plane(xmin, V, Tr, F, &Cv, &Ct);
+  Py_END_ALLOW_THREADS
+
+  if (verbosity_level>=4)
+    report_stream << fname << "::Nt=" << Tr.size() << " Nc=" << Nc << std::endl;
+
+  //
+  // Returning results
+  //
+
+  PyObject *results = PyDict_New();
+
+  PyDict_SetItemStringStealRef(results, "frac_areas", PyArray_From3DPointVector(F));
+  PyDict_SetItemStringStealRef(results, "vcomp", PyArray_FromVector(Cv));
+  PyDict_SetItemStringStealRef(results, "tcomp", PyArray_FromVector(Ct));
+  PyDict_SetItemStringStealRef(results, "ncrossing", PyInt_FromLong(Nc));
+
+  return results;
+}
+
 /*
   C++ wrapper for Python code:
 
@@ -10235,7 +10885,7 @@ static PyObject *wd_atmint(PyObject *self, PyObject *args, PyObject *keywds) {
 
   Python:
 
-    results = interp(req, axes, grid)
+    results = interp(req, axes, grid, <keyword>=<value>)
 
   with arguments:
     req: 2-rank numpy array = MxN array (M rows, N columns) where
@@ -10249,6 +10899,24 @@ static PyObject *wd_atmint(PyObject *self, PyObject *args, PyObject *keywds) {
           where Ni are lengths of individual axes, and the last element
           is the vertex value of dimension Nv
 
+  keywords: optional
+
+    clamp: boolean, default False
+          if the point is out of bounds or hits a missing (NaN) node,
+          clamp it to the range of the axes and interpolate again
+
+    fallback: tuple (axes_f, grid_f), default None
+          grid used for points whose value is still NaN; grid_f has to
+          have the same dimension of the values Nv
+
+    fallback_cols: tuple of integers, default (0, 1, .., Nf-1)
+          columns of req (each in [0, N)) used as the coordinates on the
+          fallback grid with Nf axes, e.g. (0,) to fall back to a blackbody
+          table over Teff
+
+    status: boolean, default False
+          return also the status flags of individual points
+
   Example: we have the following vertices with corresponding values:
 
     v0 = (0, 2), f(v0) = 5
@@ -10265,6 +10933,19 @@ static PyObject *wd_atmint(PyObject *self, PyObject *args, PyObject *keywds) {
 
   Return:
     2-rank numpy array = MxNv array of interpolated values
+
+  or if status is True a tuple
+
+    (results, flags)
+
+  where flags is 1-rank numpy array of uint8 = M array with bits
+  (see Tinterp_status)
+
+      1 - out of bounds of the axes
+      2 - hit a missing (NaN) node of the grid
+      4 - clamped to the range of the axes
+      8 - obtained from the fallback grid
+     16 - failed, the value is NaN
 */
 
 static PyObject *interp(PyObject *self, PyObject *args, PyObject *keywds) {
@@ -10272,19 +10953,29 @@ static PyObject *interp(PyObject *self, PyObject *args, PyObject *keywds) {
         (char*)"req",
         (char*)"axes",
         (char*)"grid",
+        (char*)"clamp",
+        (char*)"fallback",
+        (char*)"fallback_cols",
+        (char*)"status",
         NULL
     };
 
-    PyObject *o_axes;
+    PyObject *o_axes, *o_fallback = 0, *o_fallback_cols = 0;
 
     // PyObject *o_req, *o_grid;
     PyArrayObject *o_req, *o_grid;
 
+    int b_clamp = 0, b_status = 0;
+
     if (!PyArg_ParseTupleAndKeywords(
-          args, keywds, "O!O!O!", kwlist,
+          args, keywds, "O!O!O!|pO!O!p", kwlist,
           &PyArray_Type, &o_req,
           &PyTuple_Type, &o_axes,
-          &PyArray_Type, &o_grid))
+          &PyArray_Type, &o_grid,
+          &b_clamp,
+          &PyTuple_Type, &o_fallback,
+          &PyTuple_Type, &o_fallback_cols,
+          &b_status))
         {
           raise_exception("interp::argument type mismatch: req and grid need to be numpy arrays and axes a tuple of numpy arrays.");
           return NULL;
@@ -10361,6 +11052,72 @@ static PyObject *interp(PyObject *self, PyObject *args, PyObject *keywds) {
         }
     }
 
+  //
+  // Unpack the fallback grid
+  //
+
+  int Nf = 0, *Lf = 0, *Cf = 0;
+
+  double **Af = 0;
+
+  PyArrayObject *o_grid_f = 0;
+
+  if (o_fallback) {
+
+    PyObject *o_axes_f;
+
+    if (PyTuple_Size(o_fallback) != 2 ||
+        !PyTuple_Check(o_axes_f = PyTuple_GET_ITEM(o_fallback, 0)) ||
+        !PyArray_Check(PyTuple_GET_ITEM(o_fallback, 1))) {
+      raise_exception("interp::fallback needs to be a tuple (axes, grid).");
+      Py_DECREF(o_req1);
+      Py_DECREF(o_grid1);
+      delete [] L;
+      delete [] A;
+      return NULL;
+    }
+
+    o_grid_f = (PyArrayObject *)PyArray_FROM_OTF(PyTuple_GET_ITEM(o_fallback, 1), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+    Nf = PyTuple_Size(o_axes_f);
+
+    if (!o_grid_f || PyArray_NDIM(o_grid_f) != Nf + 1 || PyArray_DIM(o_grid_f, Nf) != Nv ||
+        (o_fallback_cols && PyTuple_Size(o_fallback_cols) != Nf)) {
+      raise_exception("interp::fallback grid is not compatible with the grid.");
+      Py_DECREF(o_req1);
+      Py_DECREF(o_grid1);
+      Py_XDECREF(o_grid_f);
+      delete [] L;
+      delete [] A;
+      return NULL;
+    }
+
+    Lf = new int [2*Nf];
+    Cf = Lf + Nf;
+    Af = new double* [Nf];
+
+    for (int i = 0; i < Nf; ++i) {
+      PyArrayObject *p = (PyArrayObject *) PyTuple_GET_ITEM(o_axes_f, i);
+      Lf[i] = (int) PyArray_DIM(p, 0);
+      Af[i] = (double *) PyArray_DATA(p);
+      Cf[i] = (o_fallback_cols ? (int)PyLong_AsLong(PyTuple_GET_ITEM(o_fallback_cols, i)) : i);
+    }
+
+    // the columns are read from the points of req
+    for (int i = 0; i < Nf; ++i)
+      if (Cf[i] < 0 || Cf[i] >= Na) {
+        raise_exception("interp::fallback_cols are not valid columns of req.");
+        Py_DECREF(o_req1);
+        Py_DECREF(o_grid1);
+        Py_DECREF(o_grid_f);
+        delete [] L;
+        delete [] A;
+        delete [] Lf;
+        delete [] Af;
+        return NULL;
+      }
+  }
+
   //
   // Prepare for returned values
   //
@@ -10375,144 +11132,1333 @@ static PyObject *interp(PyObject *self, PyObject *args, PyObject *keywds) {
   double *R = (double *) PyArray_DATA((PyArrayObject *)o_ret);
   #endif
 
+  PyObject *o_status = 0;
+
+  std::uint8_t *S = 0;
+
+  if (b_status) {
+    o_status = PyArray_SimpleNew(1, dims, NPY_UINT8);
+    S = (std::uint8_t *) PyArray_DATA((PyArrayObject *)o_status);
+  }
+
   //
   // Do interpolation
   //
 
   Tlinear_interpolation<double> lin_iterp(Na, Nv, L, A, G);
 
-  for (double *q = Q, *r = R, *re = r + Nr; r != re; q += Na, r += Nv)
-    lin_iterp.get(q, r);
+  if (!b_clamp && !o_fallback && !b_status) {
+
+    for (double *q = Q, *r = R, *re = r + Nr; r != re; q += Na, r += Nv)
+      lin_iterp.get(q, r);
+
+  } else {
+
+    Tlinear_interpolation<double> *fb_iterp =
+      (o_fallback ? new Tlinear_interpolation<double>(Nf, Nv, Lf, Af, (double*)PyArray_DATA(o_grid_f)) : 0);
+
+    double *qc = new double [Na + Nf], *qf = qc + Na;
+
+    std::uint8_t st;
+
+    for (int i = 0; i < Np; ++i) {
+
+      double *q = Q + i*Na, *r = R + i*Nv;
+
+      if (!lin_iterp.get(q, r))
+        st = interp_out_of_bounds;
+      else if (std::isnan(r[0]))
+        st = interp_missing_node;
+      else
+        st = interp_ok;
+
+      if (st != interp_ok) {
+
+        if (b_clamp && lin_iterp.clamp(q, qc)) {
+          lin_iterp.get(qc, r);
+          st |= interp_clamped;
+        }
+
+        if (fb_iterp && std::isnan(r[0])) {
+          for (int j = 0; j < Nf; ++j) qf[j] = q[Cf[j]];
+          fb_iterp->get(qf, r);
+          st |= interp_fallback;
+        }
+
+        if (std::isnan(r[0])) st |= interp_failed;
+      }
+
+      if (S) S[i] = st;
+    }
+
+    delete [] qc;
+
+    if (fb_iterp) delete fb_iterp;
+  }
 
   // clean copies of objects
   Py_DECREF(o_req1);
   Py_DECREF(o_grid1);
+  Py_XDECREF(o_grid_f);
 
   // Clean data about axes
   delete [] L;
   delete [] A;
 
+  if (Lf) delete [] Lf;
+  if (Af) delete [] Af;
+
+  if (o_status) return Py_BuildValue("NN", o_ret, o_status);
+
   return o_ret;
 }
 
 /*
-  Calculate cosine of the angle of scalar projections
-
-    r[i] = x[i].y[i]/(|x[i]| |y[i]|)    i = 0, ..., n -1
+  Reading per-triangle parameters given as floats or 1-rank numpy arrays.
+  Parameters of length 1 are used for all triangles.
 
   Input:
-    x : 2-rank numpy array
-    y : 2-rank numpy array
+    m - number of parameters
+    o - array of python objects
+
+  Output:
+    o1 - array of converted numpy arrays (new references)
+    p - array of pointers to data
+    np - array of lengths of parameters
+    n - number of triangles
 
   Return:
-    r: 1- rank numpy array
+    true if successful, otherwise false and the exception is set
 */
-static PyObject *scalproj_cosangle(PyObject *self, PyObject *args) {
+bool PyArray_ReadParameters(
+  const std::string &fname,
+  int m,
+  PyObject **o,
+  PyArrayObject **o1,
+  double **p,
+  int *np,
+  int &n) {
 
-  auto fname = "vec_proj"_s;
+  n = 1;
 
-  PyArrayObject *o_x, *o_y;
+  for (int i = 0; i < m; ++i) {
 
-  if  (!PyArg_ParseTuple(args,
-        "O!O!",
-        &PyArray_Type, &o_x,
-        &PyArray_Type, &o_y)
-      ){
-    raise_exception(fname +  "::Problem reading arguments");
-    return NULL;
-  }
+    o1[i] = (PyArrayObject *)PyArray_FROM_OTF(o[i], NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
 
-  int n = PyArray_DIM(o_x, 0);
+    if (!o1[i]) {
+      raise_exception(fname + "::Parameters need to be floats or arrays of floats");
+      for (int j = 0; j < i; ++j) Py_DECREF(o1[j]);
+      return false;
+    }
 
-  npy_intp dims = n;
+    np[i] = PyArray_SIZE(o1[i]);
+    p[i] = (double *)PyArray_DATA(o1[i]);
 
-  double
-    s, x, y,
-    *px = (double*)PyArray_DATA(o_x),
-    *py = (double*)PyArray_DATA(o_y);
+    if (np[i] != 1) {
+      if (n != 1 && np[i] != n) {
+        raise_exception(fname + "::Parameters have inconsistent lengths");
+        for (int j = 0; j <= i; ++j) Py_DECREF(o1[j]);
+        return false;
+      }
+      n = np[i];
+    }
+  }
 
-  #if defined(USING_SimpleNewFromData)
-  double *r = new double [n];
-  PyObject *o_r = PyArray_SimpleNewFromData(1, &dims, NPY_DOUBLE, r);
-  PyArray_ENABLEFLAGS((PyArrayObject *)o_r, NPY_ARRAY_OWNDATA);
-  #else
-  PyObject *o_r = PyArray_SimpleNew(1, &dims, NPY_DOUBLE);
-  double *r = (double *)PyArray_DATA((PyArrayObject *)o_r);
-  #endif
+  return true;
+}
 
-  for (double *p = r, *pe = r + n; pe != p; ++p) {
+/*
+  Preparing 1-rank numpy array of floats for n results: either the
+  given preallocated array, which is checked, or a new array.
 
-    s = x = y = 0;
-    for (int i = 0; i < 3; ++i, ++px, ++py) {
-     s += (*px)*(*py);
-     x += (*px)*(*px);
-     y += (*py)*(*py);
-    }
+  Input:
+    o_out - preallocated array or NULL
+    n - number of results
 
-    *p = s/std::sqrt(x*y);
+  Return:
+    new reference to the array or NULL and the exception is set
+*/
+PyObject *PyArray_PrepareOutput(const std::string &fname, PyObject *o_out, int n) {
+
+  if (o_out) {
+    if (PyArray_TYPE((PyArrayObject *)o_out) != NPY_DOUBLE ||
+        !PyArray_IS_C_CONTIGUOUS((PyArrayObject *)o_out) ||
+        !PyArray_ISALIGNED((PyArrayObject *)o_out) ||
+        PyArray_SIZE((PyArrayObject *)o_out) != n) {
+      raise_exception(fname + "::out needs to be a C-contiguous array of floats of matching length", PyExc_ValueError);
+      return NULL;
+    }
+    if (!PyArray_ISWRITEABLE((PyArrayObject *)o_out)) {
+      raise_exception(fname + "::out needs to be writeable", PyExc_ValueError);
+      return NULL;
+    }
+    Py_INCREF(o_out);
+    return o_out;
   }
 
-  return o_r;
+  npy_intp dims = n;
+  return PyArray_SimpleNew(1, &dims, NPY_DOUBLE);
 }
 
-
 /*
-  C++ wrapper for Python code:
+  C++ wrapper for python code:
 
-  Calculate the area, volume and dvolume/dOmega of the left or right
-  side of the "Roche" contact lobe defined as equipotential of the generalized
-  Kopal potential Omega:
+    Interpolation of specific intensities I(mu) on 4-rank grids with
+    axes (Teff, logg, abun, mu) at per-triangle parameters. It is
+    equivalent to
 
-      Omega_0 = Omega(x,y,z)
+      interp(np.vstack((teff, logg, abun, mu)).T, axes, grid).T[0]
 
-  assuming F = 1. We divide the Roche contact lobe on sides by cutting
-  it with a plane x=const.
+    but without stacking of the requests and with the results written
+    directly into an (optionally preallocated) array. The search for the
+    cell of the grid is reused between consecutive triangles.
 
   Python:
 
-    dict = roche_contact_partial_area_volume(x, q, d, Omega0, <keyword>=<value>)
+    results = interp_imu(teff, logg, abun, mu, axes, grid, <keyword>=<value>)
 
-  where parameters are
+  with arguments:
 
-  positionals:
-    x: float - plane dividing left and right side
-    q: float = M2/M1 - mass ratio
-    d: float - separation between the two objects
-    Omega: float - value potential
+    teff: 1-rank numpy array or float - effective temperatures
+    logg: 1-rank numpy array or float - surface gravities
+    abun: 1-rank numpy array or float - abundances
+    mu: 1-rank numpy array - cosines of the view angle
 
-  keywords:
-    choice: integer, default 0
-            0 for discussing left lobe
-            1 for discussing right lobe
+      floats or arrays of length 1 are used for all triangles
 
-    larea: boolean, default True
-    lvolume: boolean, default True
-    ldvolume: boolean, default True
+    axes: tuple of 4 numpy arrays, with each array holding all unique
+          vertices along its respective axis in ascending order
 
-    epsA : float, default 1e-12
-      relative precision of the area
+    grid: 5-rank numpy array = N1xN2xN3xN4x1 array of log10 intensities
 
-    epsV : float, default 1e-12
-      relative precision of the volume
+  keywords: optional
 
-    epsdV : float, default 1e-12
-      relative precision of the dvolume/dOmega
+    out: 1-rank numpy array of floats, default None
+          array into which the results are stored
 
-  Returns:
+    pow10: boolean, default False
+          return 10^(interpolated value) instead of the interpolated value
 
-    dictionary
+    status: boolean, default False
+          return also the status flags of individual points (see interp)
 
-  with keywords
-    larea: area of the left or right Roche lobe
-      float:
+  Return:
+    1-rank numpy array of interpolated values
 
-    lvolume: volume of the left or right Roche lobe
-      float:
+  or if status is True a tuple
 
-    ldvolume: dvolume/dOmega of the left or right Roche lobe
-      float:
+    (results, flags)
+*/
+static PyObject *interp_imu(PyObject *self, PyObject *args, PyObject *keywds) {
 
-    Example:
+  auto fname = "interp_imu"_s;
+
+  char *kwlist[] = {
+    (char*)"teff",
+    (char*)"logg",
+    (char*)"abun",
+    (char*)"mu",
+    (char*)"axes",
+    (char*)"grid",
+    (char*)"out",
+    (char*)"pow10",
+    (char*)"status",
+    NULL
+  };
+
+  PyObject *o_par[4], *o_axes, *o_out = 0;
+
+  PyArrayObject *o_grid;
+
+  int b_pow10 = 0, b_status = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(
+        args, keywds, "OOOOO!O!|O!pp", kwlist,
+        o_par, o_par + 1, o_par + 2, o_par + 3,
+        &PyTuple_Type, &o_axes,
+        &PyArray_Type, &o_grid,
+        &PyArray_Type, &o_out,
+        &b_pow10,
+        &b_status)
+      ){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  const int Na = 4;
+
+  if (PyTuple_Size(o_axes) != Na || PyArray_NDIM(o_grid) != Na + 1 || PyArray_DIM(o_grid, Na) != 1) {
+    raise_exception(fname + "::Axes and grid need to describe a 4-rank grid of scalars");
+    return NULL;
+  }
+
+  //
+  // Read parameters of triangles
+  //
+
+  PyArrayObject *o_par1[Na];
+
+  int n, np[Na];
+
+  double *par[Na];
+
+  if (!PyArray_ReadParameters(fname, Na, o_par, o_par1, par, np, n)) return NULL;
+
+  PyArrayObject *o_grid1 = (PyArrayObject *)PyArray_FROM_OTF((PyObject *)o_grid, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_grid1) {
+    raise_exception(fname + "::Grid needs to be an array of floats");
+    for (int i = 0; i < Na; ++i) Py_DECREF(o_par1[i]);
+    return NULL;
+  }
+
+  //
+  // Prepare output
+  //
+
+  if (!(o_out = PyArray_PrepareOutput(fname, o_out, n))) {
+    for (int i = 0; i < Na; ++i) Py_DECREF(o_par1[i]);
+    Py_DECREF(o_grid1);
+    return NULL;
+  }
+
+  double *R = (double *)PyArray_DATA((PyArrayObject *)o_out);
+
+  std::uint8_t *S = 0;
+
+  PyObject *o_status = 0;
+
+  if (b_status) {
+    npy_intp dims = n;
+    o_status = PyArray_SimpleNew(1, &dims, NPY_UINT8);
+    S = (std::uint8_t *) PyArray_DATA((PyArrayObject *)o_status);
+  }
+
+  //
+  // Interpolate
+  //
+
+  int L[Na];
+
+  double *A[Na], q[Na];
+
+  for (int i = 0; i < Na; ++i) {
+    PyArrayObject *p = (PyArrayObject *) PyTuple_GET_ITEM(o_axes, i);
+    L[i] = (int) PyArray_DIM(p, 0);
+    A[i] = (double *) PyArray_DATA(p);
+  }
+
+  Tlinear_interpolation<double> lin_iterp(Na, 1, L, A, (double *) PyArray_DATA(o_grid1));
+
+  for (int k = 0; k < n; ++k) {
+
+    for (int i = 0; i < Na; ++i) q[i] = par[i][np[i] == 1 ? 0 : k];
+
+    bool ok = lin_iterp.get(q, R + k);
+
+    if (S) S[k] = (ok ? (std::isnan(R[k]) ? interp_missing_node | interp_failed : interp_ok) : interp_out_of_bounds | interp_failed);
+
+    if (b_pow10) R[k] = std::pow(10.0, R[k]);
+  }
+
+  for (int i = 0; i < Na; ++i) Py_DECREF(o_par1[i]);
+  Py_DECREF(o_grid1);
+
+  if (o_status) return Py_BuildValue("NN", o_out, o_status);
+
+  return o_out;
+}
+
+/*
+  Lookup of limb darkening coefficients from a table over (Teff, logg, abun)
+  and evaluation of the LD model at per-triangle mu.
+
+  The interpolated coefficients are cached per triangle together with
+  the triangle's (Teff, logg, abun). In the next call only the triangles
+  with changed parameters are interpolated again, e.g. for circular
+  orbits the coefficients are interpolated only at the first epoch.
+*/
+struct Tld_lookup {
+
+  TLDmodel_type type;
+
+  int
+    nr_par,     // number of parameters of the LD model
+    offset,     // index of the first parameter in the table
+    Nv,         // number of values in the table
+    L[3];
+
+  double *A[3];
+
+  PyArrayObject *o_axes[3], *o_table;
+
+  Tlinear_interpolation<double> *lin_interp;
+
+  std::vector<double> key, coeffs, buf;
+
+  std::vector<std::uint8_t> flags;
+
+  Tld_lookup(
+    PyArrayObject *o_axes_[3],
+    PyArrayObject *o_table_,
+    TLDmodel_type type,
+    int offset)
+  : type(type), nr_par(LD::nrpar(type)), offset(offset), o_table(o_table_) {
+
+    for (int i = 0; i < 3; ++i) {
+      o_axes[i] = o_axes_[i];
+      L[i] = PyArray_DIM(o_axes[i], 0);
+      A[i] = (double *)PyArray_DATA(o_axes[i]);
+    }
+
+    Nv = PyArray_DIM(o_table, 3);
+
+    buf.resize(Nv);
+
+    lin_interp = new Tlinear_interpolation<double>(3, Nv, L, A, (double *)PyArray_DATA(o_table));
+  }
+
+  ~Tld_lookup(){
+    delete lin_interp;
+    for (int i = 0; i < 3; ++i) Py_DECREF(o_axes[i]);
+    Py_DECREF(o_table);
+  }
+
+  /*
+    Update the cached coefficients for n triangles with parameters
+    par[i][k] (or par[i][0] if np[i] == 1).
+
+    Return:
+      number of triangles for which coefficients were interpolated
+  */
+  int update(int n, double **par, int *np) {
+
+    if ((int)flags.size() != n) {
+      key.assign(3*n, std::numeric_limits<double>::quiet_NaN());
+      coeffs.resize(nr_par*n);
+      flags.resize(n);
+    }
+
+    int nr = 0;
+
+    double q[3], *k_ = key.data();
+
+    for (int k = 0; k < n; ++k, k_ += 3) {
+
+      for (int i = 0; i < 3; ++i) q[i] = par[i][np[i] == 1 ? 0 : k];
+
+      if (q[0] == k_[0] && q[1] == k_[1] && q[2] == k_[2]) continue;
+
+      k_[0] = q[0];
+      k_[1] = q[1];
+      k_[2] = q[2];
+
+      bool ok = lin_interp->get(q, buf.data());
+
+      flags[k] = (ok ?
+        (std::isnan(buf[offset]) ? interp_missing_node | interp_failed : interp_ok) :
+        interp_out_of_bounds | interp_failed);
+
+      std::copy(buf.begin() + offset, buf.begin() + offset + nr_par, coeffs.begin() + k*nr_par);
+
+      ++nr;
+    }
+
+    return nr;
+  }
+};
+
+/*
+  Destructor of the LD lookup stored in a Python capsule.
+*/
+static void ld_lookup_free(PyObject *o_lookup) {
+  delete (Tld_lookup *) PyCapsule_GetPointer(o_lookup, "libphoebe.ld_lookup");
+}
+
+/*
+  C++ wrapper for python code:
+
+    Setting up the lookup of limb darkening coefficients from a table
+    and evaluation of the LD model.
+
+  Python:
+
+    lookup = ld_lookup_setup(axes, table, descr, offset)
+
+  with arguments:
+
+    axes: tuple of 3 numpy arrays (Teff, logg, abun), with each array
+          holding all unique vertices along its axis in ascending order
+    table: 4-rank numpy array = N1xN2xN3xNv array of LD coefficients
+    descr: string - LD model, e.g. b"linear", b"logarithmic", b"power"
+    offset: integer - column in table of the first coefficient of the model
+
+  Return:
+    lookup: capsule - handle used in ld_lookup_D and ld_lookup_ldint
+*/
+static PyObject *ld_lookup_setup(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "ld_lookup_setup"_s;
+
+  char *kwlist[] = {
+    (char*)"axes",
+    (char*)"table",
+    (char*)"descr",
+    (char*)"offset",
+    NULL
+  };
+
+  PyObject *o_axes, *o_table, *o_descr;
+
+  int offset;
+
+  if (!PyArg_ParseTupleAndKeywords(
+        args, keywds, "O!OO!i", kwlist,
+        &PyTuple_Type, &o_axes,
+        &o_table,
+        &PyString_Type, &o_descr,
+        &offset)
+      ){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  TLDmodel_type type = LD::type(PyString_AsString(o_descr));
+
+  if (type == NONE) {
+    raise_exception(fname + "::This model is not supported");
+    return NULL;
+  }
+
+  if (PyTuple_Size(o_axes) != 3) {
+    raise_exception(fname + "::Expecting three axes (Teff, logg, abun)");
+    return NULL;
+  }
+
+  PyArrayObject *o_axes1[3], *o_table1;
+
+  for (int i = 0; i < 3; ++i)
+    o_axes1[i] = (PyArrayObject *)PyArray_FROM_OTF(PyTuple_GET_ITEM(o_axes, i), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  o_table1 = (PyArrayObject *)PyArray_FROM_OTF(o_table, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_axes1[0] || !o_axes1[1] || !o_axes1[2] || !o_table1 ||
+      PyArray_NDIM(o_table1) != 4 ||
+      offset < 0 || offset + LD::nrpar(type) > PyArray_DIM(o_table1, 3)) {
+    raise_exception(fname + "::Axes and table are not compatible with the LD model");
+    for (int i = 0; i < 3; ++i) Py_XDECREF(o_axes1[i]);
+    Py_XDECREF(o_table1);
+    return NULL;
+  }
+
+  // lookup owns the references to the converted axes and table
+  Tld_lookup *lookup = new Tld_lookup(o_axes1, o_table1, type, offset);
+
+  return PyCapsule_New(lookup, "libphoebe.ld_lookup", ld_lookup_free);
+}
+
+/*
+  Common part of ld_lookup_D and ld_lookup_ldint: evaluating per-triangle
+  values from the LD coefficients.
+*/
+static PyObject *ld_lookup_eval(
+  const std::string &fname,
+  PyObject *args,
+  PyObject *keywds,
+  bool with_mu) {
+
+  char *kwlist_D[] = {
+    (char*)"lookup",
+    (char*)"teff",
+    (char*)"logg",
+    (char*)"abun",
+    (char*)"mu",
+    (char*)"out",
+    (char*)"status",
+    NULL
+  };
+
+  char *kwlist_ldint[] = {
+    (char*)"lookup",
+    (char*)"teff",
+    (char*)"logg",
+    (char*)"abun",
+    (char*)"out",
+    (char*)"status",
+    NULL
+  };
+
+  PyObject *o_lookup, *o_par[4], *o_out = 0;
+
+  int b_status = 0;
+
+  bool ok = (with_mu ?
+    PyArg_ParseTupleAndKeywords(
+        args, keywds, "OOOOO|O!p", kwlist_D,
+        &o_lookup, o_par, o_par + 1, o_par + 2, o_par + 3,
+        &PyArray_Type, &o_out, &b_status) :
+    PyArg_ParseTupleAndKeywords(
+        args, keywds, "OOOO|O!p", kwlist_ldint,
+        &o_lookup, o_par, o_par + 1, o_par + 2,
+        &PyArray_Type, &o_out, &b_status));
+
+  if (!ok) {
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  Tld_lookup *lookup = (Tld_lookup *) PyCapsule_GetPointer(o_lookup, "libphoebe.ld_lookup");
+
+  if (!lookup) {
+    raise_exception(fname + "::First argument is not a LD lookup handle");
+    return NULL;
+  }
+
+  int m = (with_mu ? 4 : 3), n, np[4];
+
+  PyArrayObject *o_par1[4];
+
+  double *par[4];
+
+  if (!PyArray_ReadParameters(fname, m, o_par, o_par1, par, np, n)) return NULL;
+
+  if (!(o_out = PyArray_PrepareOutput(fname, o_out, n))) {
+    for (int i = 0; i < m; ++i) Py_DECREF(o_par1[i]);
+    return NULL;
+  }
+
+  lookup->update(n, par, np);
+
+  double *R = (double *)PyArray_DATA((PyArrayObject *)o_out),
+         *c = lookup->coeffs.data();
+
+  int nr_par = lookup->nr_par;
+
+  if (with_mu) {
+    double *mu = par[3];
+    bool all = np[3] != 1;
+    for (int k = 0; k < n; ++k, c += nr_par)
+      R[k] = LD::D(lookup->type, mu[all ? k : 0], c);
+  } else
+    for (int k = 0; k < n; ++k, c += nr_par)
+      R[k] = LD::D0(lookup->type, c)/utils::m_pi;
+
+  for (int i = 0; i < m; ++i) Py_DECREF(o_par1[i]);
+
+  if (b_status) {
+    npy_intp dims = n;
+    PyObject *o_status = PyArray_SimpleNew(1, &dims, NPY_UINT8);
+    std::copy(lookup->flags.begin(), lookup->flags.end(), (std::uint8_t *)PyArray_DATA((PyArrayObject *)o_status));
+    return Py_BuildValue("NN", o_out, o_status);
+  }
+
+  return o_out;
+}
+
+/*
+  C++ wrapper for python code:
+
+    Evaluating the LD model D(mu) with coefficients looked up in the table
+    of the handle at per-triangle parameters.
+
+  Python:
+
+    D = ld_lookup_D(lookup, teff, logg, abun, mu, <keyword>=<value>)
+
+  with arguments:
+
+    lookup: capsule - handle returned by ld_lookup_setup
+    teff, logg, abun, mu: 1-rank numpy arrays or floats
+
+  keywords: optional
+
+    out: 1-rank numpy array of floats, default None
+          array into which the results are stored
+
+    status: boolean, default False
+          return also the status flags of individual triangles (see interp)
+
+  Return:
+    1-rank numpy array of D(mu) or if status is True a tuple (D, flags)
+*/
+static PyObject *ld_lookup_D(PyObject *self, PyObject *args, PyObject *keywds) {
+  return ld_lookup_eval("ld_lookup_D"_s, args, keywds, true);
+}
+
+/*
+  C++ wrapper for python code:
+
+    Evaluating the integral of the LD model D0/pi, also named ldint,
+    with coefficients looked up in the table of the handle at per-triangle
+    parameters.
+
+  Python:
+
+    ldint = ld_lookup_ldint(lookup, teff, logg, abun, <keyword>=<value>)
+
+  with arguments and keywords as in ld_lookup_D, but without mu.
+
+  Return:
+    1-rank numpy array of ldint or if status is True a tuple (ldint, flags)
+*/
+static PyObject *ld_lookup_ldint(PyObject *self, PyObject *args, PyObject *keywds) {
+  return ld_lookup_eval("ld_lookup_ldint"_s, args, keywds, false);
+}
+
+/*
+  C++ wrapper for python code:
+
+    Imputing missing values (NaN) in gridded data by linear interpolation
+    along the axes of the grid. Missing nodes are detected by the first
+    value at the node being NaN. The grid is changed in place.
+
+  Python:
+
+    n = interp_impute(grid, <keyword>=<value>)
+
+  with arguments:
+
+    grid: N+1-rank numpy array =  N1xN2x...xNNxNv array,
+          where Ni are lengths of individual axes, and the last element
+          is the vertex value of dimension Nv. It has to be a C-contiguous
+          array of floats.
+
+  keywords: optional
+
+    axes: tuple of N numpy arrays, with each array holding all unique
+          vertices along its respective axis in ascending order.
+          If not given the interpolation is done w.r.t. indices of the grid.
+
+    max_iter: integer, default 100
+          maximal number of sweeps over the grid
+
+  Return:
+    n: integer - number of imputed nodes
+*/
+
+static PyObject *interp_impute(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "interp_impute"_s;
+
+  char *kwlist[] = {
+    (char*)"grid",
+    (char*)"axes",
+    (char*)"max_iter",
+    NULL
+  };
+
+  PyArrayObject *o_grid;
+
+  PyObject *o_axes = 0;
+
+  int max_iter = 100;
+
+  if (!PyArg_ParseTupleAndKeywords(
+        args, keywds, "O!|O!i", kwlist,
+        &PyArray_Type, &o_grid,
+        &PyTuple_Type, &o_axes,
+        &max_iter)
+      ){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  if (PyArray_TYPE(o_grid) != NPY_DOUBLE ||
+      !PyArray_IS_C_CONTIGUOUS(o_grid) ||
+      !PyArray_ISWRITEABLE(o_grid)) {
+    raise_exception(fname + "::grid needs to be a writeable C-contiguous array of floats");
+    return NULL;
+  }
+
+  int Na = PyArray_NDIM(o_grid) - 1;
+
+  if (Na < 1) {
+    raise_exception(fname + "::grid needs to be at least of rank 2");
+    return NULL;
+  }
+
+  if (o_axes && PyTuple_Size(o_axes) != Na) {
+    raise_exception(fname + "::Number of axes does not match the grid");
+    return NULL;
+  }
+
+  int
+    Nv = PyArray_DIM(o_grid, Na),
+    *L = new int [Na];
+
+  double
+    *G = (double *)PyArray_DATA(o_grid),
+    **A = (o_axes ? new double* [Na] : 0);
+
+  for (int i = 0; i < Na; ++i) {
+    L[i] = PyArray_DIM(o_grid, i);
+    if (A) A[i] = (double *) PyArray_DATA((PyArrayObject *)PyTuple_GET_ITEM(o_axes, i));
+  }
+
+  int n = impute_grid(Na, Nv, L, A, G, max_iter);
+
+  delete [] L;
+  if (A) delete [] A;
+
+  return PyInt_FromLong(n);
+}
+
+/*
+  C++ wrapper for python code:
+
+    Creating the axes and grid of values from scattered rows of
+    parameters and corresponding data, i.e. the pixel type grid used
+    by interp.
+
+  Python:
+
+    axes, grid = interp_grid(pars, data)
+
+  with arguments:
+
+    pars: 2-rank numpy array = NxM array, one row per parameter
+    data: 2-rank numpy array = NvxM array, data corresponding to
+          the columns of pars
+
+  Return:
+    axes: tuple of N numpy arrays holding the unique values of the
+          parameters in ascending order
+
+    grid: N+1-rank numpy array =  N1xN2x...xNNxNv array,
+          where Ni are lengths of individual axes. Nodes not given
+          in pars are NaN. For repeated parameters the last column wins.
+*/
+static PyObject *interp_grid(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "interp_grid"_s;
+
+  char *kwlist[] = {
+    (char*)"pars",
+    (char*)"data",
+    NULL
+  };
+
+  PyObject *o_pars, *o_data;
+
+  if (!PyArg_ParseTupleAndKeywords(
+        args, keywds, "OO", kwlist, &o_pars, &o_data)
+      ){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  PyArrayObject
+    *o_pars1 = (PyArrayObject *)PyArray_FROM_OTF(o_pars, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY),
+    *o_data1 = (PyArrayObject *)PyArray_FROM_OTF(o_data, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_pars1 || !o_data1 ||
+      PyArray_NDIM(o_pars1) != 2 || PyArray_NDIM(o_data1) != 2 ||
+      PyArray_DIM(o_pars1, 1) != PyArray_DIM(o_data1, 1) ||
+      PyArray_DIM(o_pars1, 0) < 1) {
+    raise_exception(fname + "::pars and data need to be 2-rank arrays with the same number of columns");
+    Py_XDECREF(o_pars1);
+    Py_XDECREF(o_data1);
+    return NULL;
+  }
+
+  int
+    Na = PyArray_DIM(o_pars1, 0),
+    Nv = PyArray_DIM(o_data1, 0);
+
+  long Ng = PyArray_DIM(o_pars1, 1);
+
+  std::vector<std::vector<double>> A;
+
+  std::vector<long> U;
+
+  grid_axes(Na, Ng, (double *)PyArray_DATA(o_pars1), A, U);
+
+  Py_DECREF(o_pars1);
+
+  PyObject *o_axes = PyTuple_New(Na);
+
+  std::vector<npy_intp> dims(Na + 1);
+
+  for (int i = 0; i < Na; ++i) {
+    dims[i] = A[i].size();
+    PyTuple_SET_ITEM(o_axes, i, PyArray_FromVector(A[i]));
+  }
+
+  dims[Na] = Nv;
+
+  PyObject *o_grid = PyArray_SimpleNew(Na + 1, dims.data(), NPY_DOUBLE);
+
+  if (!o_grid) {
+    raise_exception(fname + "::Grid could not be allocated");
+    Py_DECREF(o_axes);
+    Py_DECREF(o_data1);
+    return NULL;
+  }
+
+  double
+    *G = (double *)PyArray_DATA((PyArrayObject *)o_grid),
+    *D = (double *)PyArray_DATA(o_data1);
+
+  std::fill(G, G + PyArray_SIZE((PyArrayObject *)o_grid), std::numeric_limits<double>::quiet_NaN());
+
+  for (long k = 0; k < Ng; ++k) {
+    double *g = G + U[k]*Nv;
+    for (int j = 0; j < Nv; ++j) g[j] = D[j*Ng + k];
+  }
+
+  Py_DECREF(o_data1);
+
+  return Py_BuildValue("NN", o_axes, o_grid);
+}
+
+/*
+  Destructor of the B-spline stored in a Python capsule.
+*/
+static void bspline_free(PyObject *o_spline) {
+  delete (Tbspline<double> *) PyCapsule_GetPointer(o_spline, "libphoebe.bspline");
+}
+
+/*
+  C++ wrapper for python code:
+
+    Setting up a 1D B-spline given by knots, coefficients and degree
+    for fast repeated evaluation, e.g. of the blackbody passband
+    intensities as function of Teff.
+
+  Python:
+
+    spline = bspline_setup(t, c, k)
+
+  with arguments:
+
+    t: 1-rank numpy array - knots in ascending order
+    c: 1-rank numpy array - coefficients of the B-spline
+    k: integer - degree of the spline, k <= 7
+
+    The arguments are the same as returned by scipy.interpolate.splrep.
+    The data are copied.
+
+  Return:
+    spline: capsule - handle of the spline used in bspline_eval
+*/
+static PyObject *bspline_setup(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "bspline_setup"_s;
+
+  char *kwlist[] = {
+    (char*)"t",
+    (char*)"c",
+    (char*)"k",
+    NULL
+  };
+
+  PyObject *o_t, *o_c;
+
+  int k;
+
+  if (!PyArg_ParseTupleAndKeywords(
+        args, keywds, "OOi", kwlist, &o_t, &o_c, &k)
+      ){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  PyArrayObject
+    *o_t1 = (PyArrayObject *)PyArray_FROM_OTF(o_t, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY),
+    *o_c1 = (PyArrayObject *)PyArray_FROM_OTF(o_c, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_t1 || !o_c1) {
+    raise_exception(fname + "::Knots and coefficients need to be arrays of floats");
+    Py_XDECREF(o_t1);
+    Py_XDECREF(o_c1);
+    return NULL;
+  }
+
+  int n = PyArray_DIM(o_t1, 0);
+
+  if (k < 1 || k > 7 || n < 2*k + 2 || PyArray_DIM(o_c1, 0) < n - k - 1) {
+    raise_exception(fname + "::Inconsistent knots, coefficients and degree");
+    Py_DECREF(o_t1);
+    Py_DECREF(o_c1);
+    return NULL;
+  }
+
+  Tbspline<double> *spline =
+    new Tbspline<double>(n, (double*)PyArray_DATA(o_t1), (double*)PyArray_DATA(o_c1), k);
+
+  Py_DECREF(o_t1);
+  Py_DECREF(o_c1);
+
+  return PyCapsule_New(spline, "libphoebe.bspline", bspline_free);
+}
+
+/*
+  C++ wrapper for python code:
+
+    Evaluating the B-spline prepared by bspline_setup.
+
+  Python:
+
+    y = bspline_eval(spline, x)
+
+  with arguments:
+
+    spline: capsule - handle returned by bspline_setup
+    x: float or 1-rank numpy array - arguments
+
+  Return:
+    y: float or 1-rank numpy array - values of the spline
+*/
+static PyObject *bspline_eval(PyObject *self, PyObject *args) {
+
+  auto fname = "bspline_eval"_s;
+
+  PyObject *o_spline, *o_x;
+
+  if (!PyArg_ParseTuple(args, "OO", &o_spline, &o_x)) {
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  Tbspline<double> *spline =
+    (Tbspline<double> *) PyCapsule_GetPointer(o_spline, "libphoebe.bspline");
+
+  if (!spline) {
+    raise_exception(fname + "::First argument is not a B-spline handle");
+    return NULL;
+  }
+
+  if (PyFloat_Check(o_x))
+    return PyFloat_FromDouble((*spline)(PyFloat_AS_DOUBLE(o_x)));
+
+  PyArrayObject *o_x1 =
+    (PyArrayObject *)PyArray_FROM_OTF(o_x, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_x1) {
+    raise_exception(fname + "::This type of arguments is not supported");
+    return NULL;
+  }
+
+  PyObject *o_y = PyArray_SimpleNew(PyArray_NDIM(o_x1), PyArray_DIMS(o_x1), NPY_DOUBLE);
+
+  spline->eval(
+    PyArray_SIZE(o_x1),
+    (double*)PyArray_DATA(o_x1),
+    (double*)PyArray_DATA((PyArrayObject *)o_y));
+
+  Py_DECREF(o_x1);
+
+  return o_y;
+}
+
+/*
+  Destructor of the cubic interpolation stored in a Python capsule.
+*/
+static void cubic_interp_free(PyObject *o_interp) {
+  delete (Tcubic_interpolation<double> *) PyCapsule_GetPointer(o_interp, "libphoebe.cubic_interp");
+}
+
+/*
+  C++ wrapper for python code:
+
+    Setting up the multi-dimensional cubic interpolation on gridded data
+    for repeated evaluation. For the B-spline kernel the prefiltered
+    coefficients are computed once and stored in the handle.
+
+  Python:
+
+    interp = cubic_interp_setup(axes, grid, kind=b"bspline")
+
+  with arguments:
+
+    axes: tuple of N numpy arrays, with each array holding all unique
+          vertices along its respective axis in ascending order
+
+    grid: N+1-rank numpy array =  N1xN2x...xNNxNv array,
+          where Ni are lengths of individual axes, and the last element
+          is the vertex value of dimension Nv
+
+  keywords: optional
+
+    kind: string, default b"bspline"
+          kernel of the interpolation, b"bspline" for cubic B-spline or
+          b"catmull-rom" for Catmull-Rom spline
+
+    The data are copied. Missing (NaN) nodes should be imputed beforehand,
+    see interp_impute.
+
+  Return:
+    interp: capsule - handle used in cubic_interp_eval
+*/
+static PyObject *cubic_interp_setup(PyObject *self, PyObject *args, PyObject *keywds) {
+
+  auto fname = "cubic_interp_setup"_s;
+
+  char *kwlist[] = {
+    (char*)"axes",
+    (char*)"grid",
+    (char*)"kind",
+    NULL
+  };
+
+  PyObject *o_axes, *o_grid, *o_kind = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(
+        args, keywds, "O!O|O!", kwlist,
+        &PyTuple_Type, &o_axes,
+        &o_grid,
+        &PyString_Type, &o_kind)
+      ){
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  Tcubic_kernel kernel = cubic_bspline;
+
+  if (o_kind) {
+    std::string kind(PyString_AsString(o_kind));
+
+    if (kind == "catmull-rom")
+      kernel = cubic_catmull_rom;
+    else if (kind != "bspline") {
+      raise_exception(fname + "::This kind of interpolation is not supported");
+      return NULL;
+    }
+  }
+
+  int Na = PyTuple_Size(o_axes);
+
+  PyArrayObject *o_grid1 =
+    (PyArrayObject *)PyArray_FROM_OTF(o_grid, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_grid1 || Na < 1 || PyArray_NDIM(o_grid1) != Na + 1) {
+    raise_exception(fname + "::Grid is not compatible with the axes");
+    Py_XDECREF(o_grid1);
+    return NULL;
+  }
+
+  std::vector<PyArrayObject *> o_axes1(Na);
+
+  std::vector<int> L(Na);
+
+  std::vector<double *> A(Na);
+
+  bool ok = true;
+
+  for (int i = 0; i < Na; ++i) {
+    o_axes1[i] = (PyArrayObject *)PyArray_FROM_OTF(PyTuple_GET_ITEM(o_axes, i), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+    if (o_axes1[i] && PyArray_DIM(o_axes1[i], 0) == PyArray_DIM(o_grid1, i)) {
+      L[i] = PyArray_DIM(o_axes1[i], 0);
+      A[i] = (double *)PyArray_DATA(o_axes1[i]);
+    } else
+      ok = false;
+  }
+
+  Tcubic_interpolation<double> *interp = 0;
+
+  if (ok)
+    interp = new Tcubic_interpolation<double>(
+      Na, PyArray_DIM(o_grid1, Na), L.data(), A.data(),
+      (double *)PyArray_DATA(o_grid1), kernel);
+
+  for (auto && o : o_axes1) Py_XDECREF(o);
+  Py_DECREF(o_grid1);
+
+  if (!ok) {
+    raise_exception(fname + "::Axes are not compatible with the grid");
+    return NULL;
+  }
+
+  return PyCapsule_New(interp, "libphoebe.cubic_interp", cubic_interp_free);
+}
+
+/*
+  C++ wrapper for python code:
+
+    Evaluating the cubic interpolation prepared by cubic_interp_setup.
+
+  Python:
+
+    res = cubic_interp_eval(interp, req)
+
+  with arguments:
+
+    interp: capsule - handle returned by cubic_interp_setup
+
+    req: 2-rank numpy array = MxN array (M rows, N columns) where
+        each column stores the value along the respective axis and
+        each row corresponds to a single point to be interpolated
+
+  Return:
+    2-rank numpy array = MxNv array of interpolated values, points out
+    of bounds of the axes are NaN
+*/
+static PyObject *cubic_interp_eval(PyObject *self, PyObject *args) {
+
+  auto fname = "cubic_interp_eval"_s;
+
+  PyObject *o_interp, *o_req;
+
+  if (!PyArg_ParseTuple(args, "OO", &o_interp, &o_req)) {
+    raise_exception(fname + "::Problem reading arguments");
+    return NULL;
+  }
+
+  Tcubic_interpolation<double> *interp =
+    (Tcubic_interpolation<double> *) PyCapsule_GetPointer(o_interp, "libphoebe.cubic_interp");
+
+  if (!interp) {
+    raise_exception(fname + "::First argument is not a cubic interpolation handle");
+    return NULL;
+  }
+
+  PyArrayObject *o_req1 =
+    (PyArrayObject *)PyArray_FROM_OTF(o_req, NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+
+  if (!o_req1 || PyArray_NDIM(o_req1) != 2 || PyArray_DIM(o_req1, 1) != interp->Na) {
+    raise_exception(fname + "::Requested points are not compatible with the axes");
+    Py_XDECREF(o_req1);
+    return NULL;
+  }
+
+  int Np = PyArray_DIM(o_req1, 0), Na = interp->Na, Nv = interp->Nv;
+
+  npy_intp dims[2] = {Np, Nv};
+
+  PyObject *o_ret = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+
+  double
+    *Q = (double *)PyArray_DATA(o_req1),
+    *R = (double *)PyArray_DATA((PyArrayObject *)o_ret);
+
+  for (int i = 0; i < Np; ++i, Q += Na, R += Nv)
+    if (!interp->get(Q, R))
+      for (int k = 0; k < Nv; ++k) R[k] = std::numeric_limits<double>::quiet_NaN();
+
+  Py_DECREF(o_req1);
+
+  return o_ret;
+}
+
+/*
+  Calculate cosine of the angle of scalar projections
+
+    r[i] = x[i].y[i]/(|x[i]| |y[i]|)    i = 0, ..., n -1
+
+  Input:
+    x : 2-rank numpy array
+    y : 2-rank numpy array
+
+  Return:
+    r: 1- rank numpy array
+*/
+static PyObject *scalproj_cosangle(PyObject *self, PyObject *args) {
+
+  auto fname = "vec_proj"_s;
+
+  PyArrayObject *o_x, *o_y;
+
+  if  (!PyArg_ParseTuple(args,
+        "O!O!",
+        &PyArray_Type, &o_x,
+        &PyArray_Type, &o_y)
+      ){
+    raise_exception(fname +  "::Problem reading arguments");
+    return NULL;
+  }
+
+  int n = PyArray_DIM(o_x, 0);
+
+  npy_intp dims = n;
+
+  double
+    s, x, y,
+    *px = (double*)PyArray_DATA(o_x),
+    *py = (double*)PyArray_DATA(o_y);
+
+  #if defined(USING_SimpleNewFromData)
+  double *r = new double [n];
+  PyObject *o_r = PyArray_SimpleNewFromData(1, &dims, NPY_DOUBLE, r);
+  PyArray_ENABLEFLAGS((PyArrayObject *)o_r, NPY_ARRAY_OWNDATA);
+  #else
+  PyObject *o_r = PyArray_SimpleNew(1, &dims, NPY_DOUBLE);
+  double *r = (double *)PyArray_DATA((PyArrayObject *)o_r);
+  #endif
+
+  for (double *p = r, *pe = r + n; pe != p; ++p) {
+
+    s = x = y = 0;
+    for (int i = 0; i < 3; ++i, ++px, ++py) {
+     s += (*px)*(*py);
+     x += (*px)*(*px);
+     y += (*py)*(*py);
+    }
+
+    *p = s/std::sqrt(x*y);
+  }
+
+  return o_r;
+}
+
+
+/*
+  C++ wrapper for Python code:
+
+  Calculate the area, volume and dvolume/dOmega of the left or right
+  side of the "Roche" contact lobe defined as equipotential of the generalized
+  Kopal potential Omega:
+
+      Omega_0 = Omega(x,y,z)
+
+  assuming F = 1. We divide the Roche contact lobe on sides by cutting
+  it with a plane x=const.
+
+  Python:
+
+    dict = roche_contact_partial_area_volume(x, q, d, Omega0, <keyword>=<value>)
+
+  where parameters are
+
+  positionals:
+    x: float - plane dividing left and right side
+    q: float = M2/M1 - mass ratio
+    d: float - separation between the two objects
+    Omega: float - value potential
+
+  keywords:
+    choice: integer, default 0
+            0 for discussing left lobe
+            1 for discussing right lobe
+
+    larea: boolean, default True
+    lvolume: boolean, default True
+    ldvolume: boolean, default True
+
+    epsA : float, default 1e-12
+      relative precision of the area
+
+    epsV : float, default 1e-12
+      relative precision of the volume
+
+    epsdV : float, default 1e-12
+      relative precision of the dvolume/dOmega
+
+  Returns:
+
+    dictionary
+
+  with keywords
+    larea: area of the left or right Roche lobe
+      float:
+
+    lvolume: volume of the left or right Roche lobe
+      float:
+
+    ldvolume: dvolume/dOmega of the left or right Roche lobe
+      float:
+
+    Example:
     import libphoebe
 
     x=0.7       # where we cut it
@@ -11775,6 +13721,13 @@ static PyMethodDef Methods[] = {
     "of the generalized Kopal potential Omega0. The edge of triangles "
     "used in the mesh are approximately delta."},
 
+  { "roche_wd_mesh",
+    (PyCFunction)roche_wd_mesh,
+    METH_VARARGS|METH_KEYWORDS,
+    "Determine the Wilson-Devinney style discretization of the primary "
+    "generalized Roche lobe for given values of q, F, d and value of "
+    "the generalized Kopal potential Omega0 with N rings per quadrant."},
+
 // --------------------------------------------------------------------
 
   { "mesh_visibility",
@@ -11800,6 +13753,12 @@ static PyMethodDef Methods[] = {
     METH_VARARGS|METH_KEYWORDS,
     "Calculate the properties of the triangular mesh."},
 
+  { "mesh_split_by_plane",
+    (PyCFunction)mesh_split_by_plane,
+    METH_VARARGS|METH_KEYWORDS,
+    "Split the triangular mesh by the plane x = xmin and calculate "
+    "fractional areas of triangles crossing the plane."},
+
   { "mesh_export_povray",
     (PyCFunction)mesh_export_povray,
     METH_VARARGS|METH_KEYWORDS,
@@ -11945,6 +13904,58 @@ static PyMethodDef Methods[] = {
     METH_VARARGS|METH_KEYWORDS,
     "Multi-dimensional linear interpolation of arrays with gridded data."},
 
+  {"interp_imu",
+    (PyCFunction)interp_imu,
+    METH_VARARGS|METH_KEYWORDS,
+    "Interpolation of specific intensities on (Teff, logg, abun, mu) grids "
+    "at per-triangle parameters."},
+
+  {"ld_lookup_setup",
+    (PyCFunction)ld_lookup_setup,
+    METH_VARARGS|METH_KEYWORDS,
+    "Setting up the lookup of LD coefficients from a (Teff, logg, abun) table."},
+
+  {"ld_lookup_D",
+    (PyCFunction)ld_lookup_D,
+    METH_VARARGS|METH_KEYWORDS,
+    "Evaluating the LD model with looked up coefficients at per-triangle mu."},
+
+  {"ld_lookup_ldint",
+    (PyCFunction)ld_lookup_ldint,
+    METH_VARARGS|METH_KEYWORDS,
+    "Evaluating the integral of the LD model with looked up coefficients."},
+
+  {"interp_impute",
+    (PyCFunction)interp_impute,
+    METH_VARARGS|METH_KEYWORDS,
+    "Imputing missing values in gridded data by linear interpolation along "
+    "the axes."},
+
+  {"interp_grid",
+    (PyCFunction)interp_grid,
+    METH_VARARGS|METH_KEYWORDS,
+    "Creating axes and grid of values from scattered rows of parameters and data."},
+
+  {"bspline_setup",
+    (PyCFunction)bspline_setup,
+    METH_VARARGS|METH_KEYWORDS,
+    "Setting up 1D B-spline given by knots, coefficients and degree."},
+
+  {"bspline_eval",
+    bspline_eval,
+    METH_VARARGS,
+    "Evaluating 1D B-spline prepared by bspline_setup."},
+
+  {"cubic_interp_setup",
+    (PyCFunction)cubic_interp_setup,
+    METH_VARARGS|METH_KEYWORDS,
+    "Setting up multi-dimensional cubic interpolation on gridded data."},
+
+  {"cubic_interp_eval",
+    cubic_interp_eval,
+    METH_VARARGS,
+    "Evaluating cubic interpolation prepared by cubic_interp_setup."},
+
 // --------------------------------------------------------------------
 
   {"scalproj_cosangle",
@@ -50,6 +50,17 @@ struct Tmarching: public Tbody {
 
   bool precision;
 
+  // use Hessian in projections (Halley's method) and predictions of
+  // new vertices, off by default as the vertices (and so the mesh)
+  // differ slightly from those of plain Newton steps
+  bool use_hessian;
+
+  // statistics of projections onto the surface:
+  //   nr_proj - number of projections
+  //   nr_grad - number of evaluations of the gradient and constrain
+  //   nr_hess - number of evaluations of the Hessian
+  long nr_proj, nr_grad, nr_hess;
+
   /*
    Create internal vertex (copy point and generate base)
 
@@ -138,6 +149,76 @@ struct Tmarching: public Tbody {
   #undef DEBUG
   #endif
 
+  /*
+    Step of the projection onto the surface r' = r - fac grad(F) with
+    the Newton step corrected by the curvature along the gradient
+    (Halley's method for F(r - t grad(F)) = 0):
+
+      fac = F/|grad F|^2 /(1 - F grad(F).H.grad(F)/(2|grad F|^4))
+
+    Input:
+      r - point near the surface
+      g - (grad F, F) at r
+
+    Return:
+      fac
+  */
+  T projection_step(T r[3], T g[4]){
+
+    ++nr_grad;
+
+    T g2 = utils::norm2(g), fac = g[3]/g2;
+
+    // close to the surface Newton's method converges in the same number
+    // of steps and the Hessian is not worth evaluating
+    if (use_hessian && std::abs(fac)*std::sqrt(g2) > 1e-5) {
+
+      T H[3][3] = {{0}}, s = 0;
+
+      this->hessian(r, H);
+      ++nr_hess;
+
+      for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) s += g[i]*H[i][j]*g[j];
+
+      T d = 1 - 0.5*fac*s/g2;
+
+      // far from the surface Halley's correction can not be trusted
+      if (d > 0.5 && d < 2) fac /= d;
+    }
+
+    return fac;
+  }
+
+  /*
+    Predict the point on the surface reached by the step u in the
+    tangent plane of the vertex v, using the normal curvature in the
+    direction u:
+
+      q = r + u + h n,    h = - u.H.u/(2|grad F|)
+
+    which is correct to the second order in |u|.
+
+    Input:
+      v - vertex
+      H - Hessian at the vertex
+      u - step in tangent plane
+
+    Output:
+      q - predicted point
+  */
+  void predict_point(Tvertex & v, T H[3][3], T u[3], T q[3]){
+
+    T h = 0;
+
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j) h += u[i]*H[i][j]*u[j];
+
+    h *= -0.5/v.norm;
+
+    for (int i = 0; i < 3; ++i) q[i] = v.r[i] + u[i] + h*v.b[2][i];
+  }
+
   /*
     Projecting a point r positioned near the surface onto surface anc
     calculate vertex. The surface is defined as
@@ -159,6 +240,8 @@ struct Tmarching: public Tbody {
   //#define DEBUG
   bool project_onto_potential(T ri[3], Tvertex & v, const int & max_iter, T *ni = 0, const T & eps = 20*std::numeric_limits<T>::epsilon()){
 
+    ++nr_proj;
+
     //
     // Newton-Raphson iteration to solve F(u_k - t grad(F))=0
     //
@@ -186,8 +269,8 @@ struct Tmarching: public Tbody {
           if (sum < 0) return false;
         }
 
-        // fac = F/|grad(F)|^2
-        fac = g[3]/utils::norm2(g);
+        // fac = F/|grad(F)|^2, corrected by the curvature
+        fac = projection_step(r, g);
 
         // dr = F/|grad(F)|^2 grad(F)
         // r' = r - dr
@@ -329,6 +412,8 @@ struct Tmarching: public Tbody {
     //
     // Newton-Raphson iteration to solve F(u_k - t grad(F))=0
     //
+    ++nr_proj;
+
     int it = 0;
 
     T g[4], t, dr1, r1, fac;
@@ -350,8 +435,8 @@ struct Tmarching: public Tbody {
           if (sum < 0) return false;
         }
 
-        // fac = F/|grad(F)|^2
-        fac = g[3]/utils::norm2(g);
+        // fac = F/|grad(F)|^2, corrected by the curvature
+        fac = projection_step(r, g);
 
         // dr = F/|grad(F)|^2 grad(F)
         // r' = r - dr
@@ -418,6 +503,8 @@ struct Tmarching: public Tbody {
   // #define DEBUG
   bool project_onto_potential(T ri[3], T r[3], T n[3], const int & max_iter, T *gnorm = 0, const T & eps = 20*std::numeric_limits<T>::epsilon()){
 
+    ++nr_proj;
+
     //
     // Newton-Raphson iteration to solve F(u_k - t grad(F))=0
     //
@@ -440,8 +527,8 @@ struct Tmarching: public Tbody {
         // g = (grad F, F)
         this->grad(r, g, precision);
 
-        // fac = F/|grad(F)|^2
-        fac = g[3]/utils::norm2(g);
+        // fac = F/|grad(F)|^2, corrected by the curvature
+        fac = projection_step(r, g);
 
         // dr = F/|grad(F)|^2 grad(F)
         // r' = r - dr
@@ -537,7 +624,8 @@ struct Tmarching: public Tbody {
   }
 
 
-  Tmarching(T *params) : Tbody(params) { }
+  Tmarching(T *params) : Tbody(params),
+    use_hessian(false), nr_proj(0), nr_grad(0), nr_hess(0) { }
 
   /*
     Triangulation using marching method of genus 0 closed and surfaces
@@ -575,7 +663,7 @@ struct Tmarching: public Tbody {
 
     const int max_iter = 100;
 
-    T qk[3];
+    T qk[3], H[3][3] = {{0}};
 
     Tvertex v, vk, *vp, Pi[6];
 
@@ -754,6 +842,12 @@ struct Tmarching: public Tbody {
         //calc_sincos(nt - 1, domega, sa, ca, delta/std::sqrt(c*c + s*s));
         utils::sincos_array(nt - 1, domega, sa, ca, delta/std::hypot(c, s));
 
+        // Hessian at it_min for predicting new vertices
+        if (use_hessian) {
+          this->hessian(it_min->r, H);
+          ++nr_hess;
+        }
+
         vp = Pi;        // new front from it_min
         n = V.size();   // size of the set of vertices
 
@@ -767,6 +861,8 @@ struct Tmarching: public Tbody {
           for (int i = 0; i < 3; ++i)
             qk[i] = it_min->r[i] + (u[i] = it_min->b[0][i]*ct + it_min->b[1][i]*st);
 
+          if (use_hessian) predict_point(*it_min, H, u, qk);
+
           if (!project_onto_potential(qk, *vp, max_iter, it_min->b[2]) &&
               !slide_over_potential(it_min->r, it_min->b[2], u, delta, *vp, max_iter)) {
 
@@ -1169,10 +1265,16 @@ struct Tmarching: public Tbody {
             // returning fac*(sin(k domega), cos(k domega))
             // where fac = delta/|(c, s)|
 
-            T sa[6], ca[6], u[3];
+            T sa[6], ca[6], u[3], H[3][3] = {{0}};
 
             utils::sincos_array(nt - 1, domega, sa, ca, delta/std::hypot(c, s));
 
+            // Hessian at it_min for predicting new vertices
+            if (use_hessian) {
+              this->hessian(it_min->r, H);
+              ++nr_hess;
+            }
+
             int n = V.size();             // size of the set of vertices
 
             T st, ct, qk[3];
@@ -1189,6 +1291,8 @@ struct Tmarching: public Tbody {
               for (int i = 0; i < 3; ++i)
                 qk[i] = it_min->r[i] + (u[i] = it_min->b[0][i]*ct + it_min->b[1][i]*st);
 
+              if (use_hessian) predict_point(*it_min, H, u, qk);
+
               if (!project_onto_potential(qk, *vp, max_iter, it_min->b[2]) &&
                   !slide_over_potential(it_min->r, it_min->b[2], u, delta, *vp, max_iter)) {
 
@@ -1728,10 +1832,16 @@ struct Tmarching: public Tbody {
             // returning fac*(sin(k domega), cos(k domega))
             // where fac = delta/|(c, s)|
 
-            T sa[6], ca[6], u[3];
+            T sa[6], ca[6], u[3], H[3][3] = {{0}};
 
             utils::sincos_array(nt - 1, domega, sa, ca, delta/std::hypot(c, s));
 
+            // Hessian at it_min for predicting new vertices
+            if (use_hessian) {
+              this->hessian(it_min->r, H);
+              ++nr_hess;
+            }
+
             int n = V.size();             // size of the set of vertices
 
             T st, ct, qk[3];
@@ -1748,6 +1858,8 @@ struct Tmarching: public Tbody {
               for (int i = 0; i < 3; ++i)
                 qk[i] = it_min->r[i] + (u[i] = it_min->b[0][i]*ct + it_min->b[1][i]*st);
 
+              if (use_hessian) predict_point(*it_min, H, u, qk);
+
               if (!project_onto_potential(qk, *vp, max_iter, it_min->b[2]) &&
                   !slide_over_potential(it_min->r, it_min->b[2], u, delta, *vp, max_iter)) {
 
@@ -14,6 +14,9 @@
 #include <list>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
 
 #include "utils.h"
 
@@ -700,6 +703,238 @@ void mesh_attributes(
   }
 }
 
+/*
+  Spreading the lowest 21 bits of x so that two zero bits are placed
+  between each of them. Used to interleave coordinates into Morton codes.
+
+  Ref:
+  * https://en.wikipedia.org/wiki/Z-order_curve
+*/
+inline std::uint64_t morton_spread(std::uint64_t x) {
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffffULL;
+  x = (x | x << 16) & 0x1f0000ff0000ffULL;
+  x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+  x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+  x = (x | x << 2)  & 0x1249249249249249ULL;
+  return x;
+}
+
+/*
+  Permute elements of the vector in place
+
+  Input:
+    X - vector of elements
+    P - permutation: new X[i] = old X[P[i]]
+*/
+template <class T>
+void mesh_permute(std::vector<T> & X, const std::vector<int> & P) {
+
+  if (X.size() != P.size()) return;
+
+  std::vector<T> Y(X.size());
+
+  auto it = Y.begin();
+
+  for (auto && i : P) *(it++) = X[i];
+
+  X.swap(Y);
+}
+
+/*
+  Reorder vertices and triangles of the mesh along the Morton (Z-order)
+  space-filling curve so that spatial neighbours are also close in memory.
+  Vertices are sorted by the codes of their positions and triangles by the
+  smallest index of their vertices, so that triangles are visited in the
+  same order as vertices. Indices in triangles are updated accordingly.
+
+  Input:
+    V - vector of vertices
+    NatV - vector of normals at vertices
+    Tr - vector of triangles
+    GatV - vector of gradients at vertices (optional)
+
+  Output:
+    V, NatV, Tr, GatV - reordered
+    Pv - permutation of vertices: new V[i] = old V[Pv[i]]
+    Pt - permutation of triangles: new Tr[i] = old Tr[Pt[i]]
+*/
+template <class T>
+void mesh_reorder_morton(
+  std::vector <T3Dpoint<T>> & V,
+  std::vector <T3Dpoint<T>> & NatV,
+  std::vector <T3Dpoint<int>> & Tr,
+  std::vector <T> *GatV = 0,
+  std::vector <int> *Pv = 0,
+  std::vector <int> *Pt = 0
+) {
+
+  int Nv = V.size(), Nt = Tr.size();
+
+  //
+  // Bounding box of the mesh and scaling to 21 bits per axis
+  //
+
+  T b[3][2], f[3];
+
+  for (int i = 0; i < 3; ++i) b[i][0] = b[i][1] = (Nv ? V[0][i] : 0);
+
+  for (auto && v : V)
+    for (int i = 0; i < 3; ++i) {
+      if (v[i] < b[i][0]) b[i][0] = v[i];
+      else if (v[i] > b[i][1]) b[i][1] = v[i];
+    }
+
+  for (int i = 0; i < 3; ++i)
+    f[i] = (b[i][1] > b[i][0] ? 0x1fffff/(b[i][1] - b[i][0]) : 0);
+
+  auto code = [&b, &f](const T r[3]) -> std::uint64_t {
+    return
+      morton_spread(std::uint64_t(f[0]*(r[0] - b[0][0]))) |
+      morton_spread(std::uint64_t(f[1]*(r[1] - b[1][0]))) << 1 |
+      morton_spread(std::uint64_t(f[2]*(r[2] - b[2][0]))) << 2;
+  };
+
+  std::vector<std::pair<std::uint64_t, int>> K;
+
+  //
+  // Reordering vertices
+  //
+
+  K.reserve(std::max(Nv, Nt));
+
+  for (int i = 0; i < Nv; ++i) K.emplace_back(code(V[i].data), i);
+
+  std::sort(K.begin(), K.end());
+
+  std::vector<int> P(Nv), Q(Nv);
+
+  for (int i = 0; i < Nv; ++i) Q[P[i] = K[i].second] = i;
+
+  mesh_permute(V, P);
+  mesh_permute(NatV, P);
+  if (GatV) mesh_permute(*GatV, P);
+
+  if (Pv) Pv->swap(P);
+
+  for (auto && t : Tr)
+    for (int i = 0; i < 3; ++i) t[i] = Q[t[i]];
+
+  //
+  // Reordering triangles
+  //
+
+  K.clear();
+
+  for (int i = 0; i < Nt; ++i) {
+    int *t = Tr[i].data;
+    K.emplace_back(std::min(t[0], std::min(t[1], t[2])), i);
+  }
+
+  std::sort(K.begin(), K.end());
+
+  P.resize(Nt);
+
+  for (int i = 0; i < Nt; ++i) P[i] = K[i].second;
+
+  mesh_permute(Tr, P);
+
+  if (Pt) Pt->swap(P);
+}
+
+/*
+  Split the mesh by the plane x = x0 (ie. the neck of the contact envelope)
+  and calculate fractional areas of triangles crossing the plane.
+
+  Vertices with x > x0 belong to component 1 and others to component 0.
+  Triangles are assigned to components by the x-coordinate of their
+  centroids. A triangle crossing the plane is clipped along its two edges
+  cut by the plane into a triangle containing the lone vertex on one side
+  and a quadrilateral containing the other two vertices. The lone vertex
+  gets the fractional area of the triangle and the other two vertices half
+  of the fractional area of the quadrilateral each. Vertices of triangles
+  not crossing the plane have fractional area 1.
+
+  Input:
+    x0 - position of the plane
+    V - vector of vertices
+    Tr - vector of triangles
+
+  Output:
+    F - vector of fractional areas at vertices of triangles
+    Cv - component of vertices (optional)
+    Ct - component of triangles (optional)
+
+  Return:
+    number of triangles crossing the plane
+*/
+template <class T>
+int mesh_split_plane(
+  const T & x0,
+  std::vector <T3Dpoint<T>> & V,
+  std::vector <T3Dpoint<int>> & Tr,
+  std::vector <T3Dpoint<T>> & F,
+  std::vector <int> *Cv = 0,
+  std::vector <int> *Ct = 0
+) {
+
+  int Nv = V.size(), Nt = Tr.size(), Nc = 0;
+
+  std::vector<char> S(Nv);
+
+  for (int i = 0; i < Nv; ++i) S[i] = (V[i][0] > x0);
+
+  if (Cv) Cv->assign(S.begin(), S.end());
+
+  F.assign(Nt, T3Dpoint<T>(T(1)));
+
+  if (Ct) Ct->resize(Nt);
+
+  for (int i = 0; i < Nt; ++i) {
+
+    int *t = Tr[i].data;
+
+    T *v[3] = {V[t[0]].data, V[t[1]].data, V[t[2]].data};
+
+    if (Ct) (*Ct)[i] = (v[0][0] + v[1][0] + v[2][0] > 3*x0);
+
+    // number of vertices on the side of component 1
+    int s = S[t[0]] + S[t[1]] + S[t[2]];
+
+    if (s == 0 || s == 3) continue;
+
+    ++Nc;
+
+    // index of the lone vertex on its side of the plane
+    int k = 0;
+
+    while ((S[t[k]] != 0) == (s == 2)) ++k;
+
+    int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+
+    // intersections of the plane with edges k-k1 and k-k2
+    T p1[3], p2[3],
+      f1 = (x0 - v[k][0])/(v[k1][0] - v[k][0]),
+      f2 = (x0 - v[k][0])/(v[k2][0] - v[k][0]);
+
+    for (int j = 0; j < 3; ++j) {
+      p1[j] = v[k][j] + f1*(v[k1][j] - v[k][j]);
+      p2[j] = v[k][j] + f2*(v[k2][j] - v[k][j]);
+    }
+
+    T a0 = triangle_area(v[0], v[1], v[2]);
+
+    if (a0 <= 0) continue;
+
+    T a = triangle_area(v[k], p1, p2)/a0;
+
+    F[i][k] = a;
+    F[i][k1] = F[i][k2] = (1 - a)/2;
+  }
+
+  return Nc;
+}
+
 /*
   Offseting the mesh to match the reference area by moving vertices along the normals in vertices so that the total area matches its reference value.
 
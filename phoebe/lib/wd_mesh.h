@@ -0,0 +1,251 @@
+#pragma once
+
+/*
+  Discretization of surfaces in the style of the Wilson-Devinney (WD) code.
+
+  The surface is divided in rings of constant colatitude theta and each ring
+  in elements of constant longitude step. The center of each element is
+  projected radially onto the surface and the element is represented by the
+  quadrilateral in the tangential plane at the center, bounded by the
+  directions to the corners of the element. The quadrilateral is split into
+  two triangles. Only the octant x in R, y > 0, z > 0 is computed and the
+  rest is obtained by reflections over the y- and z-directions.
+
+  Body is any of the classes in bodies.h providing
+
+    void grad(T r[3], T ret[4])       -- -grad Omega and Omega0 - Omega
+    void grad_only(T r[3], T ret[3])  -- -grad Omega
+
+  Ref:
+    * Wilson, R. E. & Devinney, E. J. 1971, ApJ, 166, 605
+    * discretize_wd_style in mesh_wd.py
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "utils.h"
+
+namespace wd_mesh {
+
+  /*
+    Number of columns of the table of triangles:
+
+      0-2: center of the element
+      3: half of the WD area of the element
+      4-12: vertices of the triangle
+      13-15: normal at the center of the element (-grad Omega)
+      16: colatitude theta of the ring
+      17: longitude phi of the first element in the ring
+      18: area of the triangle r1, r2, r3 of the element
+  */
+  const int ncols = 19;
+
+  /*
+    Project the point r dc radially onto the surface by Newton-Raphson
+    iteration along the ray.
+
+    Input:
+      body - body defining the surface
+      dc[3] - direction cosines of the ray
+      r - initial distance along the ray
+      eps - absolute precision of the distance
+      max_iter - maximal number of iterations
+
+    Output:
+      r - distance of the surface along the ray
+
+    Return:
+      true if the iteration converged
+  */
+  template <class T, class Tbody>
+  bool project_along_ray(
+    Tbody & body,
+    T dc[3],
+    T & r,
+    const T & eps = 1e-12,
+    const int & max_iter = 100) {
+
+    int it = 0;
+
+    T r0 = 0, x[3], g[4];
+
+    while (std::abs(r - r0) > eps && it < max_iter) {
+
+      r0 = r;
+
+      for (int i = 0; i < 3; ++i) x[i] = r0*dc[i];
+
+      body.grad(x, g);
+
+      r = r0 - g[3]/(g[0]*dc[0] + g[1]*dc[1] + g[2]*dc[2]);
+
+      ++it;
+    }
+
+    return it < max_iter;
+  }
+
+  /*
+    Discretize the surface in the WD style with N rings per quadrant in
+    colatitude.
+
+    Input:
+      body - body defining the surface
+      r0 - polar radius used as the initial guess for the projections
+      N - number of rings in colatitude from the pole to the equator
+
+    Output:
+      G - table of triangles, ncols values per triangle. Each element
+          gives 8 triangles: two per octant in the order +y+z, -y+z,
+          +y-z, -y-z.
+
+    Return:
+      number of projections that did not converge
+  */
+  template <class T, class Tbody>
+  int discretize(Tbody & body, const T & r0, const int & N, std::vector<T> & G) {
+
+    int nfailed = 0;
+
+    std::vector<T> theta(N + 1);
+
+    for (int k = 1; k <= N + 1; ++k) theta[k - 1] = M_PI/2*(k - 0.5)/N;
+
+    // counting elements to reserve space
+    std::vector<int> M(N);
+
+    int Ne = 0;
+
+    for (int t = 0; t < N; ++t) Ne += (M[t] = int(1 + 1.3*N*std::sin(theta[t])));
+
+    G.clear();
+    G.reserve(8*ncols*Ne);
+
+    T phi, phi0, dphi, dtheta, st, ct,
+      rc[3], dc[3], vc[3], nc[3], l[4][3], r[4][3], *p,
+      rmag, vn, vv, nn, cosgamma, dsigma, s[3], s0, a2, dsigma_t;
+
+    // indices of vertices of the two triangles of the element
+    const int tri[2][3] = {{0, 1, 2}, {2, 3, 0}};
+
+    // signs of y and z in the octants
+    const T sgn[4][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+
+    for (int t = 0; t < N; ++t) {
+
+      dtheta = theta[t + 1] - theta[t];
+
+      st = std::sin(theta[t]);
+      ct = std::cos(theta[t]);
+
+      phi0 = M_PI*(1 - 0.5)/M[t];
+      dphi = M_PI*(2 - 0.5)/M[t] - phi0;
+
+      for (int i = 1; i <= M[t]; ++i) {
+
+        phi = M_PI*(i - 0.5)/M[t];
+
+        //
+        // Projecting the center of the element onto the surface
+        //
+
+        rc[0] = r0*st*std::cos(phi);
+        rc[1] = r0*st*std::sin(phi);
+        rc[2] = r0*ct;
+
+        rmag = std::sqrt(rc[0]*rc[0] + rc[1]*rc[1] + rc[2]*rc[2]);
+
+        dc[0] = rc[0]/rmag;
+        dc[2] = rc[2]/rmag;
+        dc[1] = std::sqrt(std::max(T(0), 1 - dc[0]*dc[0] - dc[2]*dc[2]));
+
+        if (!project_along_ray(body, dc, rmag)) ++nfailed;
+
+        for (int j = 0; j < 3; ++j) vc[j] = rmag*dc[j];
+
+        body.grad_only(vc, nc);
+
+        //
+        // Intersections of the directions to the corners of the element
+        // with the tangential plane at the center
+        //
+
+        T th[4] = {theta[t] - dtheta/2, theta[t] - dtheta/2, theta[t] + dtheta/2, theta[t] + dtheta/2},
+          ph[4] = {phi - dphi/2, phi + dphi/2, phi + dphi/2, phi - dphi/2};
+
+        vn = vc[0]*nc[0] + vc[1]*nc[1] + vc[2]*nc[2];
+
+        for (int k = 0; k < 4; ++k) {
+          p = l[k];
+          p[0] = std::sin(th[k])*std::cos(ph[k]);
+          p[1] = std::sin(th[k])*std::sin(ph[k]);
+          p[2] = std::cos(th[k]);
+
+          T f = vn/(p[0]*nc[0] + p[1]*nc[1] + p[2]*nc[2]);
+
+          for (int j = 0; j < 3; ++j) r[k][j] = f*p[j];
+        }
+
+        //
+        // Area of the element as computed by WD
+        //
+        //   dsigma = || r^2 sin(theta)/cos(gamma) dtheta dphi ||,
+        //
+        // where gamma is the angle between the radius vector and the normal.
+
+        vv = vc[0]*vc[0] + vc[1]*vc[1] + vc[2]*vc[2];
+        nn = nc[0]*nc[0] + nc[1]*nc[1] + nc[2]*nc[2];
+
+        cosgamma = vn/std::sqrt(vv)/std::sqrt(nn);
+        dsigma = std::abs(vv*st/cosgamma*dtheta*dphi);
+
+        // area of the triangle r1, r2, r3 by Heron's formula
+        s[0] = utils::hypot3(r[0][0] - r[1][0], r[0][1] - r[1][1], r[0][2] - r[1][2]);
+        s[1] = utils::hypot3(r[0][0] - r[2][0], r[0][1] - r[2][1], r[0][2] - r[2][2]);
+        s[2] = utils::hypot3(r[1][0] - r[2][0], r[1][1] - r[2][1], r[1][2] - r[2][2]);
+        s0 = (s[0] + s[1] + s[2])/2;
+
+        a2 = s0*(s0 - s[0])*(s0 - s[1])*(s0 - s[2]);
+        dsigma_t = (a2 > 0 ? std::sqrt(a2) : 0);
+
+        //
+        // Storing triangles of the element reflected into all octants
+        //
+
+        for (int o = 0; o < 4; ++o) {
+
+          const T *f = sgn[o];
+
+          for (int k = 0; k < 2; ++k) {
+
+            G.push_back(vc[0]);
+            G.push_back(f[0]*vc[1]);
+            G.push_back(f[1]*vc[2]);
+
+            G.push_back(dsigma/2);
+
+            for (int j = 0; j < 3; ++j) {
+              p = r[tri[k][j]];
+              G.push_back(p[0]);
+              G.push_back(f[0]*p[1]);
+              G.push_back(f[1]*p[2]);
+            }
+
+            G.push_back(nc[0]);
+            G.push_back(f[0]*nc[1]);
+            G.push_back(f[1]*nc[2]);
+
+            G.push_back(f[1] > 0 ? theta[t] : M_PI - theta[t]);
+            G.push_back(f[0]*phi0);
+            G.push_back(dsigma_t);
+          }
+        }
+      }
+    }
+
+    return nfailed;
+  }
+
+} // namespace wd_mesh
@@ -9,6 +9,7 @@ from phoebe.constraints.expression import ConstraintVar
 from phoebe.parameters.twighelpers import _uniqueid_to_uniquetwig
 from phoebe.parameters.twighelpers import _twig_to_uniqueid
 from phoebe.frontend import tabcomplete
+from phoebe.frontend import binary as _binary
 from phoebe.dependencies import nparray, distl
 from phoebe.dependencies import crimpl as _crimpl
 from phoebe.utils import parse_json, phase_mask_inds
@@ -153,6 +154,17 @@ _meta_fields_twig = ['time', 'qualifier', 'feature', 'component',
 _meta_fields_all = _meta_fields_twig + ['twig', 'uniquetwig', 'uniqueid']
 _meta_fields_filter = _meta_fields_all + ['constraint_func', 'value']
 
+# meta-tags which are matched exactly (unless given a wildcard) and can
+# therefore be looked up in ParameterSet._get_tag_index ('time' and 'kind'
+# have their own matching rules in filter)
+_meta_fields_index = [f for f in _meta_fields_twig if f not in ['time', 'kind']] + ['uniqueid']
+_meta_attrs_index = frozenset(['_{}'.format(f) for f in _meta_fields_index])
+# incremented whenever any of these tags is changed on any Parameter, which
+# invalidates the tag indices of all ParameterSets
+_meta_tags_version = 0
+# ParameterSets with fewer Parameters are simply scanned when filtering
+_tag_index_min_params = 100
+
 _contexts = ['system', 'component', 'feature',
              'dataset', 'constraint', 'distribution', 'compute', 'model',
              'solver', 'solution', 'figure', 'server', 'setting']
@@ -514,6 +526,20 @@ def parameter_from_json(dictionary, bundle=None):
     # from the sys.modules dictionary
     cls = getattr(sys.modules[__name__], classname)
 
+    value = dictionary.get('value', None)
+    if isinstance(value, np.memmap):
+        # array from a binary file (see phoebe.frontend.binary), we'll skip
+        # set_value (which would copy the array into memory) so that it is
+        # only read from disk once accessed
+        dictionary = dict(dictionary)
+        dictionary['value'] = []
+        param = cls._from_json(bundle, **dictionary)
+        if isinstance(param, FloatArrayParameter):
+            param._value = u.Quantity(value, param.default_unit, copy=False)
+        else:
+            param._value = value
+        return param
+
     return cls._from_json(bundle, **dictionary)
 
 def _instance_in(obj, *types):
@@ -603,6 +629,7 @@ class ParameterSet(object):
         """
         self._bundle = None
         self._filter = {}
+        self._tag_index = None
 
         if isinstance(params, str):
             params = json.loads(params)
@@ -1781,7 +1808,8 @@ class ParameterSet(object):
     @classmethod
     def open(cls, filename):
         """
-        Open a ParameterSet from a JSON-formatted file.
+        Open a ParameterSet from a JSON-formatted (or binary, see
+        <phoebe.parameters.ParameterSet.save>) file.
         This is a constructor so should be called as:
 
         ```py
@@ -1806,6 +1834,8 @@ class ParameterSet(object):
             data = filename
         elif isinstance(filename, str) and "{" in filename:
             data = json.loads(filename)
+        elif _binary.is_binary(filename):
+            data = _binary.load(filename)
         else:
             filename = os.path.expanduser(filename)
             with open(filename, 'r') as f:
@@ -1818,7 +1848,7 @@ class ParameterSet(object):
 
         return cls(data)
 
-    def save(self, filename, incl_uniqueid=False, compact=False, sort_by_context=True):
+    def save(self, filename, incl_uniqueid=False, compact=False, sort_by_context=True, binary=False):
         """
         Save the ParameterSet to a JSON-formatted ASCII file.
 
@@ -1834,25 +1864,38 @@ class ParameterSet(object):
             uniqueids when reloading)
         * `compact` (bool, optional, default=False): whether to use compact
             file-formatting (may be quicker to save/load, but not as easily readable)
+        * `binary` (bool, optional, default=False): whether to save to a binary
+            file instead, in which the array values are stored as raw binary
+            blocks.  These are memory-mapped when opening the file with
+            <phoebe.parameters.ParameterSet.open> (or <phoebe.frontend.bundle.Bundle.open>),
+            so that they are only read from disk once accessed.  This is much
+            faster to save and load for large models (ie. with meshes), but
+            the file is no longer human-readable.  `compact` is ignored if
+            `binary` is True.
 
         Returns
         --------
         * (string) filename
         """
         filename = os.path.expanduser(filename)
-        f = open(filename, 'w')
-        if compact:
-            if _can_ujson:
-                ujson.dump(self.to_json(incl_uniqueid=incl_uniqueid, sort_by_context=sort_by_context),
-                           f, sort_keys=False, indent=0)
+        if binary:
+            return _binary.dump(self.to_json(incl_uniqueid=incl_uniqueid, sort_by_context=sort_by_context, keep_arrays=True),
+                                filename)
+
+        # arrays may still be memory-mapped from the file we're overwriting
+        # (see ParameterSet.open), so we can't truncate it before writing
+        with _binary.replace_file(filename, 'w') as f:
+            if compact:
+                if _can_ujson:
+                    ujson.dump(self.to_json(incl_uniqueid=incl_uniqueid, sort_by_context=sort_by_context),
+                               f, sort_keys=False, indent=0)
+                else:
+                    logger.warning("for faster compact saving, install ujson")
+                    json.dump(self.to_json(incl_uniqueid=incl_uniqueid, sort_by_context=sort_by_context),
+                              f, sort_keys=False, indent=0)
             else:
-                logger.warning("for faster compact saving, install ujson")
                 json.dump(self.to_json(incl_uniqueid=incl_uniqueid, sort_by_context=sort_by_context),
-                          f, sort_keys=False, indent=0)
-        else:
-            json.dump(self.to_json(incl_uniqueid=incl_uniqueid, sort_by_context=sort_by_context),
-                      f, sort_keys=True, indent=0, separators=(',', ': '))
-        f.close()
+                          f, sort_keys=True, indent=0, separators=(',', ': '))
 
         return filename
 
@@ -2129,6 +2172,34 @@ class ParameterSet(object):
             return self.filter(**kwargs).to_list()
         return self._params
 
+    def _get_tag_index(self):
+        """
+        Inverted index of the Parameters by the meta-tags in
+        _meta_fields_index: {tag: {value: [indices in self._params]}}.
+
+        The index is built when first needed and rebuilt only when Parameters
+        are added or removed from this ParameterSet or when a meta-tag of
+        any Parameter is changed.
+        """
+        params = self._params
+        cached = getattr(self, '_tag_index', None)
+        if cached is not None:
+            cached_params, cached_len, cached_version, index = cached
+            # keeping a reference to the list itself (rather than its id)
+            # ensures it cannot be replaced by a new list with the same id
+            if cached_params is params and cached_len == len(params) and cached_version == _meta_tags_version:
+                return index
+
+        index = {tag: {} for tag in _meta_fields_index}
+        for i, param in enumerate(params):
+            for tag, index_tag in index.items():
+                value = getattr(param, tag)
+                if isinstance(value, str):
+                    index_tag.setdefault(value, []).append(i)
+
+        self._tag_index = (params, len(params), _meta_tags_version, index)
+        return index
+
     def tolist(self, **kwargs):
         """
         Alias of <phoebe.parameters.ParameterSet.to_list>
@@ -2427,7 +2498,7 @@ class ParameterSet(object):
         """
         return iter(self.to_dict())
 
-    def to_json(self, incl_uniqueid=False, incl_none=False, exclude=[], sort_by_context=True):
+    def to_json(self, incl_uniqueid=False, incl_none=False, exclude=[], sort_by_context=True, keep_arrays=False):
         """
         Convert the <phoebe.parameters.ParameterSet> to a json-compatible
         object.
@@ -2449,6 +2520,9 @@ class ParameterSet(object):
         * `incl_none` (bool, optional, default=False): whether to include tags
             whose values are None.
         * `exclude` (list, optional, default=[]): tags to exclude when saving.
+        * `keep_arrays` (bool, optional, default=False): whether to leave array
+            values as numpy arrays instead of converting them to lists (in which
+            case the result is no longer json-compatible).
 
         Returns
         -----------
@@ -2457,12 +2531,12 @@ class ParameterSet(object):
         lst = []
         if sort_by_context:
             for context in _contexts:
-                lst += [v.to_json(incl_uniqueid=incl_uniqueid, incl_none=incl_none, exclude=exclude)
+                lst += [v.to_json(incl_uniqueid=incl_uniqueid, incl_none=incl_none, exclude=exclude, keep_arrays=keep_arrays)
                         for v in self.filter(context=context,
                                              check_visible=False,
                                              check_default=False).to_list()]
         else:
-            lst = [v.to_json(incl_uniqueid=incl_uniqueid, exclude=exclude) for v in self.to_list()]
+            lst = [v.to_json(incl_uniqueid=incl_uniqueid, exclude=exclude, keep_arrays=keep_arrays) for v in self.to_list()]
         return lst
         # return {k: v.to_json() for k,v in self.to_flat_dict().items()}
 
@@ -2807,11 +2881,29 @@ class ParameterSet(object):
                 else:
                     return self._bundle.get_value(string, context=['system', 'component'], check_default=False, check_visible=False)
 
+        # exact matches on meta-tags are looked up in the inverted index
+        # instead of scanning all parameters
+        index_keys = [key for key in kwargs.keys() if key in _meta_fields_index and
+                      isinstance(kwargs[key], str) and
+                      '*' not in kwargs[key] and '?' not in kwargs[key]]
+        if len(index_keys) and len(params) >= _tag_index_min_params:
+            index = self._get_tag_index()
+            inds = None
+            for key in sorted(index_keys, key=lambda key: len(index[key].get(kwargs[key], []))):
+                inds_key = index[key].get(kwargs[key], [])
+                inds = set(inds_key) if inds is None else inds.intersection(inds_key)
+                if not len(inds):
+                    break
+            params = [params[i] for i in sorted(inds)]
+        else:
+            index_keys = []
+
         # TODO: replace with key,value in kwargs.items()... unless there was
         # some reason that won't work?
         for key in kwargs.keys():
             if len(params) and \
                     key in _meta_fields_filter and \
+                    key not in index_keys and \
                     kwargs[key] is not None:
 
                 params = [pi for pi in params if (hasattr(pi,key) and getattr(pi,key) is not None or isinstance(kwargs[key], list) and None in kwargs[key]) and
@@ -6166,6 +6258,13 @@ class ParameterSet(object):
         return self._show_or_save(**kwargs)
 
 class Parameter(object):
+    def __setattr__(self, name, value):
+        if name in _meta_attrs_index:
+            # invalidates the tag indices of all ParameterSets
+            global _meta_tags_version
+            _meta_tags_version += 1
+        object.__setattr__(self, name, value)
+
     def __init__(self, qualifier, value=None, description='', **kwargs):
         """
         This is a generic class for a Parameter.  Any Parameter that
@@ -6519,14 +6618,13 @@ class Parameter(object):
         * (string) filename
         """
         filename = os.path.expanduser(filename)
-        f = open(filename, 'w')
-        json.dump(self.to_json(incl_uniqueid=incl_uniqueid),
-                  f, sort_keys=True, indent=0, separators=(',', ': '))
-        f.close()
+        with _binary.replace_file(filename, 'w') as f:
+            json.dump(self.to_json(incl_uniqueid=incl_uniqueid),
+                      f, sort_keys=True, indent=0, separators=(',', ': '))
 
         return filename
 
-    def to_json(self, incl_uniqueid=False, incl_none=False, exclude=[]):
+    def to_json(self, incl_uniqueid=False, incl_none=False, exclude=[], keep_arrays=False):
         """
         Convert the <phoebe.parameters.Parameter> to a json-compatible
         object.
@@ -6544,6 +6642,9 @@ class Parameter(object):
         * `incl_none` (bool, optional, default=False): whether to include tags
             whose values are None.
         * `exclude` (list, optional, default=[]): tags to exclude when saving.
+        * `keep_arrays` (bool, optional, default=False): whether to leave an
+            array value as a numpy array instead of converting it to a list (in
+            which case the result is no longer json-compatible).
 
         Returns
         -----------
@@ -6565,7 +6666,7 @@ class Parameter(object):
 
                 if isinstance(v, u.Quantity):
                     v = self.get_value() # force to be in default units
-                if isinstance(v, np.ndarray):
+                if isinstance(v, np.ndarray) and not keep_arrays:
                     # can handle N-dim arrays
                     v = v.tolist()
                 if _is_unit(v):
@@ -11374,6 +11475,7 @@ class ConstraintParameter(Parameter):
         self._vars = self._addl_vars
         self._var_params = None
         self._addl_var_params = None
+        self._compiled = None
         self._constraint_func = kwargs.get('constraint_func', None)
         self._constraint_kwargs = kwargs.get('constraint_kwargs', {})
         self._in_solar_units = kwargs.get('in_solar_units', False)
@@ -11689,6 +11791,7 @@ class ConstraintParameter(Parameter):
 
 
         self._default_unit = unit
+        self._compiled = None
 
     #@send_if_client   # TODO: this breaks
     def set_value(self, value, **kwargs):
@@ -11718,6 +11821,7 @@ class ConstraintParameter(Parameter):
         # reset the cached version of the PS - will be recomputed on next request
         self._var_params = None
         self._addl_var_params = None
+        self._compiled = None
         #~ print "***", self.uniquetwig, self.uniqueid
 
     def _update_bookkeeping(self):
@@ -11877,6 +11981,109 @@ class ConstraintParameter(Parameter):
     def __pow__(self, other):
         return self.__math__(other, '**', '__pow__')
 
+    def _get_compiled(self):
+        """
+        Lower the expression into a code object along with everything needed
+        to evaluate it without going through the twig and units machinery
+        (see <phoebe.parameters.ConstraintParameter.get_result>).  The
+        conversion of each variable into SI (or solar) units and that of the
+        result into the default units are folded into constant scale factors.
+
+        The compiled expression is cached until the expression, the constrained
+        parameter, or the default units change.  The scales of the variables
+        are only used while the variables are still in the default units they
+        were compiled for.
+
+        Returns
+        --------
+        * (tuple or None): (code, needs_builtin_or_math, namespace, variables,
+            convert_scale), with variables a list of (safe_label, param, unit,
+            scale) or None if the expression cannot be compiled (arrays
+            or non-numeric variables), in which case the expression is evaluated
+            as a string.
+        """
+        if self._compiled is not None:
+            return self._compiled if self._compiled else None
+
+        self._compiled = False
+        if self._value is None or _use_sympy:
+            return None
+
+        from phoebe.constraints import builtin
+        _constraint_builtin_funcs = [f for f in dir(builtin) if isinstance(getattr(builtin, f), types.FunctionType)]
+        _constraint_math_funcs = ['sin', 'cos', 'tan', 'arcsin', 'arccos', 'arctan', 'arctan2', 'sqrt', 'log10']
+
+        needs_builtin_or_math = False
+        for func in _constraint_builtin_funcs + _constraint_math_funcs:
+            if "{}(".format(func) in self._value:
+                needs_builtin_or_math = True
+                break
+
+        if needs_builtin_or_math:
+            namespace = {func: getattr(builtin, func) for func in _constraint_builtin_funcs + _constraint_math_funcs}
+        else:
+            namespace = {}
+
+        variables = []
+        for var in self._vars + self._addl_vars:
+            param = var.get_parameter()
+            if param.__class__.__name__ == 'FloatParameter':
+                try:
+                    if self.in_solar_units:
+                        scale = u.to_solar(param.default_unit)
+                    else:
+                        scale = param.default_unit.si.scale
+                except NotImplementedError:
+                    # no solar equivalent, the string evaluation will raise
+                    # the appropriate error
+                    return None
+            elif param.__class__.__name__ == 'IntParameter':
+                scale = None
+            else:
+                return None
+            # the unit is kept to detect changes in the default unit of the
+            # variable, for which the scale no longer applies
+            variables.append((var.safe_label, param, param._default_unit if scale is not None else None, scale))
+
+        if self.default_unit is None:
+            convert_scale = None
+        elif self.in_solar_units:
+            convert_scale = u.to_solar(self.default_unit)
+        else:
+            convert_scale = self.default_unit.to_system(u.si)[0].scale
+
+        code = compile(self._value, '<constraint>', 'eval')
+        self._compiled = (code, needs_builtin_or_math, namespace, variables, convert_scale)
+        return self._compiled
+
+    def _eval_compiled(self, compiled):
+        """
+        Evaluate the output of <phoebe.parameters.ConstraintParameter._get_compiled>
+        at the current values of all variables.  The result is in SI (or solar)
+        units.
+        """
+        code, needs_builtin_or_math, namespace, variables, convert_scale = compiled
+
+        values = namespace.copy()
+        for safe_label, param, unit, scale in variables:
+            if scale is None:
+                value = param.get_value()
+            else:
+                quantity = param._value
+                if getattr(quantity, 'unit', None) is unit and quantity.isscalar:
+                    value = np.float64(quantity.value * scale)
+                elif self.in_solar_units:
+                    value = np.float64(u.to_solar(param.get_quantity()).value)
+                else:
+                    value = np.float64(param.get_quantity().si.value)
+                if needs_builtin_or_math:
+                    # these would otherwise have been formatted into the
+                    # expression and parsed back as python floats
+                    value = float(value)
+            values[safe_label] = value
+
+        return eval(code, values)
+
     @property
     def result(self):
         """
@@ -11982,9 +12189,18 @@ class ConstraintParameter(Parameter):
 
             return {var.safe_label if safe_label else var.user_label: _value(var, string_safe_arrays, use_distribution, needs_builtin) for var in vars}
 
-        eq = self.get_value()
+        if t is None and not use_distribution:
+            compiled = self._get_compiled()
+        else:
+            compiled = None
 
-        if _use_sympy and not eq_needs_builtin(eq) and not use_distribution:
+        if compiled is not None:
+            # skip self.get_value(), which needs to update all the user_labels
+            eq = None
+        else:
+            eq = self.get_value()
+
+        if compiled is None and _use_sympy and not eq_needs_builtin(eq) and not use_distribution:
             values = get_values(self._vars+self._addl_vars, safe_label=True)
             values['I'] = 1 # CHEATING MAGIC
             # just to be safe, let's reinitialize the sympy vars
@@ -12004,52 +12220,55 @@ class ConstraintParameter(Parameter):
             #     values = get_values(self._vars+self._addl_vars, safe_label=False, string_safe_arrays=True, use_distribution=use_distribution)
             #     print("***", values)
             #     return
-            needs_builtin_or_math = eq_needs_builtin(eq)
+            needs_builtin_or_math = compiled[1] if compiled is not None else eq_needs_builtin(eq)
             if needs_builtin_or_math or use_distribution:
-                # the else (which works for np arrays) does not work for the built-in funcs
-                # this means that we can't currently support the built-in funcs WITH arrays
-                needs_builtin = eq_needs_builtin(eq, include_math=False)
-
-                # cannot do from builtin import *
-                for func in _constraint_builtin_funcs + _constraint_math_funcs:
-                    # I should be shot for doing this...
-                    # in order for eval to work, the builtin functions need
-                    # to be imported at the top-level, but I don't really want
-                    # to do from builtin import * (and even if I did, python
-                    # yells at me for doing that), so instead we'll add them
-                    # to the locals dictionary.
-                    locals()[func] = getattr(builtin, func)
-
-                # if eq.split('(')[0] in ['times_to_phases', 'phases_to_times']:
-                    # these require passing the bundle
-                    # values['b'] = self._bundle
-
-                values = get_values([v for v in self._vars+self._addl_vars if v.user_label in eq], safe_label=False, string_safe_arrays=True, use_distribution=use_distribution, needs_builtin=needs_builtin)
-
-                if needs_builtin and use_distribution:
-                    # need to parse {} in eq and get values in correct order as args (including non {}, like 1)
-                    # need to access callable func from eq
-                    funcname = eq.split("(")[0]
-                    argnames = eq.split("(")[1].split(")")[0].split(", ")
-                    args = []
-                    for argname in argnames:
-                        if argname[0] == "{":
-                            args.append(values.get(argname[1:-1]))
-                        else:
-                            args.append(float(argname) if "." in argname else int(argname))
+                if compiled is not None:
+                    value = self._eval_compiled(compiled)
+                else:
+                    # the else (which works for np arrays) does not work for the built-in funcs
+                    # this means that we can't currently support the built-in funcs WITH arrays
+                    needs_builtin = eq_needs_builtin(eq, include_math=False)
+
+                    # cannot do from builtin import *
+                    for func in _constraint_builtin_funcs + _constraint_math_funcs:
+                        # I should be shot for doing this...
+                        # in order for eval to work, the builtin functions need
+                        # to be imported at the top-level, but I don't really want
+                        # to do from builtin import * (and even if I did, python
+                        # yells at me for doing that), so instead we'll add them
+                        # to the locals dictionary.
+                        locals()[func] = getattr(builtin, func)
+
+                    # if eq.split('(')[0] in ['times_to_phases', 'phases_to_times']:
+                        # these require passing the bundle
+                        # values['b'] = self._bundle
+
+                    values = get_values([v for v in self._vars+self._addl_vars if v.user_label in eq], safe_label=False, string_safe_arrays=True, use_distribution=use_distribution, needs_builtin=needs_builtin)
+
+                    if needs_builtin and use_distribution:
+                        # need to parse {} in eq and get values in correct order as args (including non {}, like 1)
+                        # need to access callable func from eq
+                        funcname = eq.split("(")[0]
+                        argnames = eq.split("(")[1].split(")")[0].split(", ")
+                        args = []
+                        for argname in argnames:
+                            if argname[0] == "{":
+                                args.append(values.get(argname[1:-1]))
+                            else:
+                                args.append(float(argname) if "." in argname else int(argname))
 
-                    hist_samples = None
-                    vectorized = False
-                    if 'pot' in funcname or 'fillout_factor' in funcname or 'requiv_L1' in funcname:
-                        # these are particularly expensive, so we'll only use 1000 samples in the underlying histogram by default
-                        hist_samples = 1000
+                        hist_samples = None
                         vectorized = False
-                    if funcname[:2] == 't0':
-                        vectorized = True
-                    value = distl.function(locals().get(funcname), args, vectorized=vectorized, hist_samples=hist_samples)
-                else:
-                    # print("\n\n\n*** eval eq={} values={}".format(eq, values))
-                    value = eval(eq.format(**values))
+                        if 'pot' in funcname or 'fillout_factor' in funcname or 'requiv_L1' in funcname:
+                            # these are particularly expensive, so we'll only use 1000 samples in the underlying histogram by default
+                            hist_samples = 1000
+                            vectorized = False
+                        if funcname[:2] == 't0':
+                            vectorized = True
+                        value = distl.function(locals().get(funcname), args, vectorized=vectorized, hist_samples=hist_samples)
+                    else:
+                        # print("\n\n\n*** eval eq={} values={}".format(eq, values))
+                        value = eval(eq.format(**values))
 
                 if value is None:
                     if suppress_error:
@@ -12079,6 +12298,9 @@ class ConstraintParameter(Parameter):
 
 
 
+            elif compiled is not None:
+                value = self._eval_compiled(compiled)
+
             else:
                 # the following works for np arrays
 
@@ -12124,7 +12346,9 @@ class ConstraintParameter(Parameter):
                 # TODO: should we skip this when calling internally and ask for it directly in solar/si?
                 value = value.to(self.default_unit)
             else:
-                if self.in_solar_units:
+                if compiled is not None:
+                    convert_scale = compiled[4]
+                elif self.in_solar_units:
                     convert_scale = u.to_solar(self.default_unit)
                 else:
                     convert_scale = self.default_unit.to_system(u.si)[0].scale
@@ -12243,6 +12467,7 @@ class ConstraintParameter(Parameter):
             self._addl_var_params = None
 
         self._value = str(expression)
+        self._compiled = None
 
 
         #self.set_value(str(expression))
@@ -12409,7 +12634,14 @@ class JobParameter(Parameter):
         else:
             crimpl_name = ''
 
-        retrieved_fnames = self.crimpl_job.check_output([self._results_fname, self._results_fname+'.progress'])
+        if self._job_name is None:
+            # not submitted through crimpl, the results were written locally
+            # (see Bundle.import_model with detach=True)
+            retrieved_fnames = [f for f in [self._results_fname, self._results_fname+'.progress'] if os.path.exists(f)]
+            if not len(retrieved_fnames):
+                raise ValueError("results file {} not found".format(self._results_fname))
+        else:
+            retrieved_fnames = self.crimpl_job.check_output([self._results_fname, self._results_fname+'.progress'])
         if not len(retrieved_fnames):
             # try retrieving any error logs
             output_files = self.crimpl_job.output_files
@@ -12522,6 +12754,31 @@ class JobParameter(Parameter):
         return ret_ps
 
 
+    def _update_progress(self):
+        """
+        Update the value to 'progress:X%' from the progress-file written by
+        a running run_compute job (percentage of computed times/datasets).
+        Progress-files of solvers hold the solution itself and are loaded
+        by <phoebe.parameters.JobParameter.load_progress> instead.
+        """
+        try:
+            retrieved_fnames = self.crimpl_job.check_output([self._results_fname+'.progress'])
+        except Exception:
+            return
+
+        if self._results_fname+'.progress' not in retrieved_fnames:
+            return
+
+        with open(self._results_fname+'.progress', 'r') as f:
+            progress_str = f.readline()
+
+        try:
+            progress = np.round(float(progress_str.strip()), 2)
+        except ValueError:
+            return
+
+        self._value = 'progress:{}%'.format(progress)
+
     def _cleanup(self):
         try:
             os.remove(self._results_fname)
@@ -12563,7 +12820,9 @@ class JobParameter(Parameter):
 
         status = self.get_status()
         if not wait and status not in ['complete', 'error', 'killed', 'progress', 'loaded']:
-            logger.info("current status: {}, check again or use wait=True".format(status))
+            if status == 'running':
+                self._update_progress()
+            logger.info("current status: {}, check again or use wait=True".format(self._value))
             return self
 
         if wait:
@@ -0,0 +1,47 @@
+"""
+"""
+
+import phoebe
+import numpy as np
+
+
+def _bundle():
+    b = phoebe.Bundle.default_binary()
+    b.add_dataset('lc', times=phoebe.linspace(0,1,11), dataset='lc01')
+    b.add_dataset('rv', times=phoebe.linspace(0,1,11), dataset='rv01')
+    b.set_value('l3_mode', 'fraction')
+    b.set_value('l3_frac', 0.2)
+    return b
+
+def test_postprocessing(verbose=False):
+    """
+    changing parameters between two calls to run_compute, whether or not the
+    backend results are re-used, must give the same model as a fresh bundle
+    """
+    changes = [{'qualifier': 'distance', 'context': 'system', 'value': 2},
+               {'qualifier': 'l3_frac', 'value': 0.4},
+               {'qualifier': 'rv_offset', 'component': 'primary', 'value': 10}]
+
+    for change in changes:
+        change = dict(change)
+        value = change.pop('value')
+
+        b = _bundle()
+        b.run_compute(irrad_method='none', model='phoebe2model')
+        b.set_value(value=value, **change)
+        b.run_compute(irrad_method='none', model='phoebe2model', overwrite=True)
+
+        b_fresh = _bundle()
+        b_fresh.set_value(value=value, **change)
+        b_fresh.run_compute(irrad_method='none', model='phoebe2model')
+
+        for qualifier, component in [('fluxes', None), ('rvs', 'primary'), ('rvs', 'secondary')]:
+            v = b.get_value(qualifier=qualifier, component=component, context='model')
+            v_fresh = b_fresh.get_value(qualifier=qualifier, component=component, context='model')
+            if verbose: print("{}: {}@{} max diff: {}".format(change['qualifier'], qualifier, component, np.max(np.abs(v-v_fresh))))
+            assert(np.allclose(v, v_fresh, rtol=0, atol=1e-12))
+
+if __name__ == '__main__':
+    logger = phoebe.logger(clevel='INFO')
+
+    test_postprocessing(verbose=True)
@@ -0,0 +1,54 @@
+"""
+"""
+
+import phoebe
+import numpy as np
+import tempfile
+import os
+
+
+def _bundle():
+    b = phoebe.Bundle.default_binary()
+    b.add_dataset('lc', times=phoebe.linspace(0,1,11), dataset='lc01')
+    b.add_dataset('mesh', compute_times=[0], columns=['teffs'], dataset='mesh01')
+    b.run_compute(irrad_method='none', model='phoebe2model')
+    return b
+
+def _assert_same_model(b1, b2):
+    for param in b1.filter(context='model').to_list():
+        value = b2.get_value(uniqueid=param.uniqueid)
+        if isinstance(param.get_value(), np.ndarray):
+            assert(np.array_equal(param.get_value(), value))
+        else:
+            assert(param.get_value() == value)
+
+def test_roundtrip(verbose=False):
+    b = _bundle()
+    tmpdir = tempfile.mkdtemp()
+    fname = os.path.join(tmpdir, 'test.phoebe')
+
+    b.save(fname, binary=True)
+    b2 = phoebe.open(fname)
+    if verbose: print("opened {} parameters".format(len(b2.to_list())))
+    _assert_same_model(b, b2)
+
+def test_overwrite_mapped(verbose=False):
+    b = _bundle()
+    tmpdir = tempfile.mkdtemp()
+    fname = os.path.join(tmpdir, 'test.phoebe')
+
+    # overwrite the file that the arrays of b2 are still memory-mapped from,
+    # both in the json and binary format
+    for binary in [False, True]:
+        b.save(fname, binary=True)
+        b2 = phoebe.open(fname)
+        b2.save(fname, binary=binary)
+        if verbose: print("binary={}: {} bytes".format(binary, os.path.getsize(fname)))
+        _assert_same_model(b, b2)
+        _assert_same_model(b, phoebe.open(fname))
+
+if __name__ == '__main__':
+    logger = phoebe.logger(clevel='INFO')
+
+    test_roundtrip(verbose=True)
+    test_overwrite_mapped(verbose=True)
@@ -0,0 +1,36 @@
+"""
+libphoebe.bspline_eval, used for the blackbody intensities of the
+passbands, against scipy.interpolate.splev
+"""
+
+import numpy as np
+from scipy import interpolate
+import libphoebe
+
+def test_bspline_splev(verbose=False):
+    x = np.linspace(3000., 10000., 25)**1.1
+    y = np.log10(x**4/(np.exp(1e4/x)-1))
+
+    for k in [1, 3, 5]:
+        tck = interpolate.splrep(x, y, k=k, s=0)
+        spline = libphoebe.bspline_setup(*tck)
+
+        t = tck[0]
+        # all the knots, including the repeated end knots, and the points
+        # in between and beyond them
+        xs = np.concatenate([t, 0.5*(t[1:]+t[:-1]), [t[0]-500., t[-1]+500.], np.linspace(x[0], x[-1], 101)])
+
+        res = libphoebe.bspline_eval(spline, xs)
+        expected = interpolate.splev(xs, tck)
+
+        if verbose:
+            print("k={}: max relative difference {}".format(k, np.max(np.abs(res/expected-1))))
+
+        assert(np.allclose(res, expected, rtol=1e-12, atol=0))
+
+        # the end knots exactly
+        for xi in [t[0], t[-1]]:
+            assert(np.isclose(libphoebe.bspline_eval(spline, xi), interpolate.splev(xi, tck), rtol=1e-12, atol=0))
+
+if __name__ == '__main__':
+    test_bspline_splev(verbose=True)
@@ -2,6 +2,7 @@
 """
 
 import phoebe
+import numpy as np
 from nose.tools import assert_raises
 
 def test_esinw_ecosw(verbose=False):
@@ -75,9 +76,27 @@ def test_pot_filloutfactor(verbose=False):
 
     assert(b.run_checks().passed)
 
+def test_variable_default_unit(verbose=False):
+    b = phoebe.default_binary()
+    b.set_value('incl', component='binary', value=70)
+    b.run_delayed_constraints()
+
+    # the compiled constraints must not apply the scale of the previous
+    # default unit of their variables
+    b.get_parameter('incl', component='binary', context='component').set_default_unit('rad')
+    b.set_value('incl', component='binary', value=60*np.pi/180)
+    b.run_delayed_constraints()
+
+    asini = b.get_value('asini', component='binary', context='component')
+    if verbose: print("asini: {}".format(asini))
+
+    assert(np.isclose(asini, b.get_value('sma', component='binary', context='component')*np.sin(60*np.pi/180), rtol=1e-12, atol=0))
+
 if __name__ == '__main__':
     logger = phoebe.logger(clevel='WARNING')
 
     b = test_esinw_ecosw(verbose=True)
 
     b = test_pot_filloutfactor(verbose=True)
+
+    test_variable_default_unit(verbose=True)
@@ -0,0 +1,65 @@
+"""
+cubic interpolation of interp_nDgrid.cinterpolate against scipy
+"""
+
+import numpy as np
+from scipy import ndimage
+from phoebe.algorithms import interp_nDgrid
+
+def _grid():
+    axes = (np.linspace(1., 3., 6), np.linspace(-1., 1., 5))
+    x, y = np.meshgrid(*axes, indexing='ij')
+    grid = np.stack([np.sin(x)*np.exp(y), x**2-y], axis=-1)
+    return axes, grid
+
+def test_bspline_scipy(verbose=False):
+    axes, grid = _grid()
+
+    np.random.seed(0)
+    req = np.column_stack([np.random.uniform(axes[0][0], axes[0][-1], 50),
+                           np.random.uniform(axes[1][0], axes[1][-1], 50)])
+    # include the corners of the grid
+    req = np.vstack([req, [[axes[0][0], axes[1][0]], [axes[0][-1], axes[1][-1]]]])
+
+    res = interp_nDgrid.cinterpolate(req, axes, grid, order=3)
+
+    # the B-spline is prefiltered with mirror boundaries, as in scipy.ndimage
+    coords = np.array([(req[:,i]-ax[0])/(ax[1]-ax[0]) for i, ax in enumerate(axes)])
+    expected = np.column_stack([ndimage.map_coordinates(grid[...,k], coords, order=3, mode='mirror')
+                                for k in range(grid.shape[-1])])
+
+    if verbose:
+        print("max difference: {}".format(np.max(np.abs(res-expected))))
+
+    assert(np.allclose(res, expected, rtol=0, atol=1e-12))
+
+def test_cubic_nodes(verbose=False):
+    axes, grid = _grid()
+    req = np.array([[a, b] for a in axes[0] for b in axes[1]])
+
+    for kind in ['bspline', 'catmull-rom']:
+        res = interp_nDgrid.cinterpolate(req, axes, grid, order=3, kind=kind)
+
+        if verbose:
+            print("{}: max difference at the nodes: {}".format(kind, np.max(np.abs(res-grid.reshape(-1, 2)))))
+
+        assert(np.allclose(res, grid.reshape(-1, 2), rtol=0, atol=1e-12))
+
+    # out of the grid
+    res = interp_nDgrid.cinterpolate(np.array([[0., 0.], [2., 1.5]]), axes, grid, order=3)
+    assert(np.all(np.isnan(res)))
+
+    # order=1 is the linear interpolation of libphoebe.interp
+    res = interp_nDgrid.cinterpolate(np.array([[1.2, 0.1]]), axes, grid, order=1)
+    assert(np.all(np.isfinite(res)))
+
+    try:
+        interp_nDgrid.cinterpolate(req, axes, grid, order=2)
+    except ValueError:
+        pass
+    else:
+        raise AssertionError("order=2 should raise ValueError")
+
+if __name__ == '__main__':
+    test_bspline_scipy(verbose=True)
+    test_cubic_nodes(verbose=True)
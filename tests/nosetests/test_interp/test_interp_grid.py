@@ -0,0 +1,59 @@
+"""
+pixel type grids built by libphoebe.interp_grid (create_pixeltypegrid)
+against the numpy implementation it replaced
+"""
+
+import numpy as np
+import libphoebe
+
+def _pixeltypegrid_numpy(grid_pars, grid_data):
+    # the former create_pixeltypegrid, with missing nodes as nan
+    uniques = [np.unique(column, return_inverse=True) for column in grid_pars]
+    axis_values = [np.array(u[0]) for u in uniques]
+
+    par_dims = [len(u[0]) for u in uniques] + [np.shape(grid_data)[0]]
+    pixelgrid = np.full(par_dims, np.nan)
+    pixelgrid[tuple([u[1] for u in uniques])] = grid_data.T
+    return tuple(axis_values), pixelgrid
+
+def _check(grid_pars, grid_data, verbose=False):
+    axis_values, pixelgrid = libphoebe.interp_grid(grid_pars, grid_data)
+    expected_axes, expected_grid = _pixeltypegrid_numpy(grid_pars, grid_data)
+
+    if verbose:
+        print("axes {} grid {}".format([len(a) for a in axis_values], pixelgrid.shape))
+
+    assert(len(axis_values) == len(expected_axes))
+    for a, e in zip(axis_values, expected_axes):
+        assert(np.all(a == e))
+    assert(pixelgrid.shape == expected_grid.shape)
+    assert(np.array_equal(pixelgrid, expected_grid, equal_nan=True))
+
+def test_interp_grid(verbose=False):
+    np.random.seed(1)
+    x, y, z = np.linspace(0, 1, 5), np.array([-3., 0.5, 2.]), np.logspace(0, 1, 7)
+    grid_pars = np.array(np.meshgrid(x, y, z, indexing='ij')).reshape(3, -1)
+    grid_data = np.array([grid_pars[0] + 10*grid_pars[1] + 100*grid_pars[2], np.sin(grid_pars[2])])
+
+    # ordered rows
+    _check(grid_pars, grid_data, verbose)
+
+    # shuffled rows with missing nodes
+    perm = np.random.permutation(grid_pars.shape[1])[:-10]
+    _check(grid_pars[:,perm], grid_data[:,perm], verbose)
+
+def test_interp_grid_degenerate(verbose=False):
+    # an axis with a single value
+    grid_pars = np.array([[0., 1., 2., 0., 1., 2.], [5., 5., 5., 5., 5., 5.], [1., 1., 1., 2., 2., 2.]])
+    grid_data = np.arange(12.).reshape(2, 6)
+    _check(grid_pars, grid_data, verbose)
+
+    # all axes with a single value, a single row
+    _check(np.array([[1.], [2.]]), np.array([[3.], [4.]]), verbose)
+
+    # a single axis
+    _check(np.array([[3., 1., 2.]]), np.array([[30., 10., 20.]]), verbose)
+
+if __name__ == '__main__':
+    test_interp_grid(verbose=True)
+    test_interp_grid_degenerate(verbose=True)
@@ -0,0 +1,82 @@
+"""
+imputing of missing grid nodes by libphoebe.interp_impute against the
+N-D linear interpolation it replaced in Passband.impute_atmosphere_grid
+"""
+
+import numpy as np
+from scipy import interpolate
+import libphoebe
+
+def _impute_linearnd(grid):
+    # the former Passband.impute_atmosphere_grid (which only imputed the
+    # first column)
+    valid_mask = ~np.isnan(grid[...,0])
+    coords = np.array(np.nonzero(valid_mask)).T
+    values = grid[valid_mask][:,0]
+    it = interpolate.LinearNDInterpolator(coords, values, fill_value=0)
+    filled = it(list(np.ndindex(grid[...,0].shape))).reshape(grid[...,0].shape)
+    filled[filled==0] = np.nan
+    return filled
+
+def _grid(shape):
+    # linear in the indices, so that both imputations are exact
+    ind = np.indices(shape).astype(float)
+    return np.stack([10 + ind[0] + 2*ind[1] + 0.5*ind[2], 3 - ind[1]], axis=-1)
+
+def test_impute_linear(verbose=False):
+    shape = (7, 6, 5)
+    exact = _grid(shape)
+
+    grid = exact.copy()
+    # isolated nodes
+    grid[2,1,3] = grid[5,4,1] = np.nan
+    # a 3x3x3 block, the node in the middle has no valid neighbours at all
+    grid[2:5,2:5,1:4] = np.nan
+    # a corner is not bracketed along any axis
+    grid[0,0,0] = np.nan
+
+    expected = _impute_linearnd(grid)
+
+    imputed = grid.copy()
+    n = libphoebe.interp_impute(imputed)
+
+    if verbose:
+        print("imputed {} nodes, max difference {}".format(n, np.nanmax(np.abs(imputed[...,0]-expected))))
+
+    assert(n == np.sum(np.isnan(grid[...,0])) - 1)
+    assert(np.all(np.isnan(imputed[...,0]) == np.isnan(expected)))
+    assert(np.isnan(imputed[0,0,0,0]) and np.isnan(imputed[0,0,0,1]))
+    assert(np.allclose(imputed[...,0], expected, rtol=0, atol=1e-12, equal_nan=True))
+    # all the values of a node are imputed
+    mask = ~np.isnan(expected)
+    assert(np.allclose(imputed[mask], exact[mask], rtol=0, atol=1e-12))
+
+def test_impute_axes(verbose=False):
+    # non-uniform axes, linear in the axis values
+    axes = (np.array([0., 1., 3., 4.]), np.array([-2., -1.5, 0., 2., 2.5]))
+    x, y = np.meshgrid(*axes, indexing='ij')
+    exact = (1 + 2*x - y)[...,None]
+
+    grid = exact.copy()
+    grid[1:3,1:4] = np.nan
+
+    n = libphoebe.interp_impute(grid, axes=axes)
+
+    if verbose:
+        print("imputed {} nodes, max difference {}".format(n, np.max(np.abs(grid-exact))))
+
+    assert(n == 6)
+    assert(np.allclose(grid, exact, rtol=0, atol=1e-12))
+
+def test_impute_all_missing(verbose=False):
+    grid = np.full((3, 4, 2), np.nan)
+
+    n = libphoebe.interp_impute(grid)
+
+    assert(n == 0)
+    assert(np.all(np.isnan(grid)))
+
+if __name__ == '__main__':
+    test_impute_linear(verbose=True)
+    test_impute_axes(verbose=True)
+    test_impute_all_missing(verbose=True)
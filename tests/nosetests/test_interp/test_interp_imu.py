@@ -0,0 +1,58 @@
+"""
+libphoebe.interp_imu against libphoebe.interp and the checks of the
+preallocated output array
+"""
+
+import numpy as np
+import libphoebe
+
+def _grid():
+    axes = (np.array([4000., 5000., 6000.]), np.array([3.5, 4., 4.5]),
+            np.array([-0.5, 0.]), np.array([0.2, 0.6, 1.]))
+    pars = np.meshgrid(*axes, indexing='ij')
+    grid = (1 + pars[0]/1e4 + 0.1*pars[1] - pars[2] + 0.3*pars[3])[...,None]
+    return axes, grid
+
+def test_interp_imu(verbose=False):
+    axes, grid = _grid()
+
+    np.random.seed(2)
+    n = 20
+    teff, logg, mu = np.random.uniform(4000, 6000, n), np.random.uniform(3.5, 4.5, n), np.random.uniform(0.2, 1., n)
+
+    expected = libphoebe.interp(np.vstack((teff, logg, np.full(n, -0.2), mu)).T, axes, grid).T[0]
+
+    res = libphoebe.interp_imu(teff, logg, -0.2, mu, axes, grid)
+
+    if verbose:
+        print("max difference: {}".format(np.max(np.abs(res-expected))))
+
+    assert(np.allclose(res, expected, rtol=1e-14, atol=0))
+
+    out = np.zeros(n)
+    res = libphoebe.interp_imu(teff, logg, -0.2, mu, axes, grid, out=out)
+    assert(res is out)
+    assert(np.allclose(out, expected, rtol=1e-14, atol=0))
+
+def test_interp_imu_out(verbose=False):
+    axes, grid = _grid()
+    n = 4
+    teff, logg, mu = np.full(n, 5000.), np.full(n, 4.), np.full(n, 0.5)
+
+    readonly = np.zeros(n)
+    readonly.flags.writeable = False
+
+    for out in [readonly, np.zeros(2*n)[::2], np.zeros(n, dtype=np.float32), np.zeros(n+1)]:
+        try:
+            libphoebe.interp_imu(teff, logg, 0., mu, axes, grid, out=out)
+        except ValueError as err:
+            if verbose:
+                print(err)
+        else:
+            raise AssertionError("out={} should raise ValueError".format(out))
+
+    assert(np.all(readonly == 0))
+
+if __name__ == '__main__':
+    test_interp_imu(verbose=True)
+    test_interp_imu_out(verbose=True)
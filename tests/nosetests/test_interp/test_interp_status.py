@@ -0,0 +1,59 @@
+"""
+status flags of libphoebe.interp with clamping and a fallback grid
+"""
+
+import numpy as np
+import libphoebe
+
+# flags, see Tinterp_status in interpolation.h
+out_of_bounds, missing_node, clamped, fallback, failed = 1, 2, 4, 8, 16
+
+def test_clamp(verbose=False):
+    axes = (np.array([0., 1.]), np.array([2., 3.]))
+    grid = np.array([[[5.], [6.]], [[7.], [8.]]])
+    req = np.array([[0.5, 2.5], [-1., 2.5], [2., 4.]])
+
+    r, st = libphoebe.interp(req, axes, grid, clamp=True, status=True)
+
+    if verbose:
+        print("values={} status={}".format(r[:,0], st))
+
+    assert(np.allclose(r[:,0], [6.5, 5.5, 8.]))
+    assert(np.all(st == [0, out_of_bounds | clamped, out_of_bounds | clamped]))
+
+    # points hitting a missing node within the axes are not clamped
+    grid_nan = grid.copy()
+    grid_nan[1,1,0] = np.nan
+    r, st = libphoebe.interp(req, axes, grid_nan, clamp=True, status=True)
+
+    if verbose:
+        print("values={} status={}".format(r[:,0], st))
+
+    assert(st[0] == missing_node | failed)
+    assert(np.isnan(r[0,0]))
+
+def test_fallback_cols(verbose=False):
+    axes = (np.array([0., 1.]), np.array([2., 3.]))
+    grid = np.array([[[5.], [6.]], [[7.], [np.nan]]])
+    fb = ((np.array([2., 3.]),), np.array([[1.], [2.]]))
+    req = np.array([[0.5, 2.5]])
+
+    r, st = libphoebe.interp(req, axes, grid, fallback=fb, fallback_cols=(1,), status=True)
+
+    if verbose:
+        print("values={} status={}".format(r[:,0], st))
+
+    assert(np.allclose(r[:,0], [1.5]))
+    assert(np.all(st == [missing_node | fallback]))
+
+    for cols in [(2,), (-1,)]:
+        try:
+            libphoebe.interp(req, axes, grid, fallback=fb, fallback_cols=cols)
+        except TypeError:
+            pass
+        else:
+            raise AssertionError("fallback_cols={} not rejected".format(cols))
+
+if __name__ == '__main__':
+    test_clamp(verbose=True)
+    test_fallback_cols(verbose=True)
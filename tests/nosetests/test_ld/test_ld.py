@@ -200,6 +200,21 @@ def test_binary(plot=False, gen_comp=False):
 
     return b
 
+def test_ldint_scalar(plot=False):
+    # looked up ldint must be a float for scalar atmosphere parameters and
+    # match the value for arrays
+    pb = phoebe.get_passband('Johnson:V')
+    for ld_func in ['linear', 'logarithmic', 'square_root', 'quadratic', 'power']:
+        ldint = pb.ldint(Teff=6000., logg=4.3, abun=0., ldatm='ck2004', ld_func=ld_func)
+        ldints = pb.ldint(Teff=np.array([6000., 6100.]), logg=np.array([4.3, 4.3]), abun=np.zeros(2), ldatm='ck2004', ld_func=ld_func)
+
+        if plot:
+            print("ld_func={} ldint={} ldints={}".format(ld_func, ldint, ldints))
+
+        assert(np.ndim(ldint) == 0)
+        assert(ldints.shape == (2,))
+        assert(np.isclose(ldint, ldints[0], rtol=1e-12, atol=0.))
+
 if __name__ == '__main__':
     logger = phoebe.logger(clevel='INFO')
 
@@ -0,0 +1,32 @@
+"""
+  Numpy arrays of any numerical dtype passed to libphoebe must give the same
+  results as arrays of the native dtypes.
+
+"""
+
+import numpy as np
+import libphoebe
+
+def test_split_by_plane_dtypes(verbose=False):
+  r_mesh = libphoebe.roche_marching_mesh(1, 1, 1, 10, 0.05, 0, 100000, vertices=True, triangles=True)
+  V, T = r_mesh['vertices'], r_mesh['triangles']
+
+  ref = libphoebe.mesh_split_by_plane(V, T, 0.05)['frac_areas']
+
+  for vdtype, tdtype in [(np.longdouble, np.int32), (np.float32, np.int32),
+                         (np.float64, np.int8), (np.float64, np.uint8),
+                         (np.float64, np.int64)]:
+    frac_areas = libphoebe.mesh_split_by_plane(V.astype(vdtype), T.astype(tdtype), 0.05)['frac_areas']
+
+    if verbose:
+      print("{} {} max diff: {}".format(vdtype.__name__, tdtype.__name__, np.max(np.abs(frac_areas-ref))))
+
+    atol = 1e-5 if vdtype == np.float32 else 1e-14
+    assert(np.allclose(frac_areas, ref, rtol=0, atol=atol))
+
+  # non-contiguous views
+  V2 = np.repeat(V, 2, axis=0)[::2]
+  assert(np.allclose(libphoebe.mesh_split_by_plane(V2, T, 0.05)['frac_areas'], ref, rtol=0, atol=1e-14))
+
+if __name__ == '__main__':
+  test_split_by_plane_dtypes(verbose=True)
@@ -0,0 +1,81 @@
+"""
+  Regression tests of the marching meshes: the default meshes (and so the
+  synthetics computed on them) must not change unless intended.
+
+"""
+
+import phoebe
+import numpy as np
+import libphoebe
+import os
+
+# (q, F, d, Omega0, choice, ntriangles) and the mesh from the plain Newton
+# projections: (number of triangles, area, volume, sum of |coordinates| of
+# the vertices)
+_lobes = {'detached': ((1, 1, 1, 10, 0, 1000),
+                       (1158, 0.15457832458794715, 0.0057042758855128635, 97.0044036313667)),
+          'contact': ((0.5, 0.5, 1, 2.65, 2, 2000),
+                      (2280, 3.712158510068917, 0.5213532983034554, 951.2609562511605))}
+
+def _mesh(q, F, d, Omega0, choice, ntriangles, **kwargs):
+  r_av = libphoebe.roche_area_volume(q, F, d, Omega0, choice, larea=True)
+  delta = np.sqrt(r_av["larea"]/(np.sqrt(3)*ntriangles/4))
+
+  return libphoebe.roche_marching_mesh(q, F, d, Omega0, delta, choice, int(1.5*ntriangles),
+                                       vertices=True, triangles=True,
+                                       area=True, volume=True, full=True, **kwargs)
+
+def test_roche_default(verbose=False):
+  for lobe, (args, (ntriangles, area, volume, vsum)) in _lobes.items():
+    r_mesh = _mesh(*args)
+
+    if verbose:
+      print("{}: ntriangles={} area={} volume={} vsum={}".format(lobe, len(r_mesh["triangles"]), r_mesh["area"], r_mesh["volume"], np.abs(r_mesh["vertices"]).sum()))
+
+    assert(len(r_mesh["triangles"]) == ntriangles)
+    assert(np.isclose(r_mesh["area"], area, rtol=1e-12, atol=0))
+    assert(np.isclose(r_mesh["volume"], volume, rtol=1e-12, atol=0))
+    assert(np.isclose(np.abs(r_mesh["vertices"]).sum(), vsum, rtol=1e-12, atol=0))
+
+def test_roche_hessian(verbose=False):
+  # the Hessian changes the vertices, but must give an equivalent mesh
+  for lobe, (args, (ntriangles, area, volume, vsum)) in _lobes.items():
+    r_mesh = _mesh(*args, use_hessian=True)
+
+    if verbose:
+      print("{}: use_hessian ntriangles={} area={} volume={}".format(lobe, len(r_mesh["triangles"]), r_mesh["area"], r_mesh["volume"]))
+
+    assert(abs(len(r_mesh["triangles"]) - ntriangles) < 0.05*ntriangles)
+    assert(np.isclose(r_mesh["area"], area, rtol=1e-3, atol=0))
+    assert(np.isclose(r_mesh["volume"], volume, rtol=1e-3, atol=0))
+
+def _synthetics(contact, verbose=False):
+  b = phoebe.default_binary(contact_binary=contact)
+  b.add_dataset('lc', times=phoebe.linspace(0,1,21), dataset='lc01')
+  b.add_dataset('rv', times=phoebe.linspace(0,1,21), dataset='rv01')
+  b.run_compute(irrad_method='none', model='phoebe2model')
+
+  b.import_model(os.path.join(os.path.dirname(__file__), 'test_marching_{}.comp.model'.format('contact' if contact else 'detached')), model='compmodel')
+
+  # tolerances are far below the changes by any change of the mesh, but
+  # allow for round-off in the rest of the computations
+  for qualifier, component, atol in [('fluxes', None, 1e-8), ('rvs', 'primary', 1e-4), ('rvs', 'secondary', 1e-4)]:
+    value = b.get_value(qualifier=qualifier, component=component, model='phoebe2model')
+    comp_value = b.get_value(qualifier=qualifier, component=component, model='compmodel')
+
+    if verbose:
+      print("contact={} {}@{} max diff: {}".format(contact, qualifier, component, np.max(np.abs(value-comp_value))))
+
+    assert(np.allclose(value, comp_value, rtol=0, atol=atol))
+
+def test_synthetics_detached(verbose=False):
+  _synthetics(False, verbose=verbose)
+
+def test_synthetics_contact(verbose=False):
+  _synthetics(True, verbose=verbose)
+
+if __name__ == '__main__':
+  test_roche_default(verbose=True)
+  test_roche_hessian(verbose=True)
+  test_synthetics_detached(verbose=True)
+  test_synthetics_contact(verbose=True)
@@ -0,0 +1,131 @@
+"""
+  Entries of the on-disk mesh cache: hits and misses, keys that change with
+  MESH_VERSION, eviction of the least recently used entries and removal of
+  temporary directories left behind by crashed processes.
+
+"""
+
+import os
+import time
+import shutil
+import tempfile
+import numpy as np
+
+import phoebe
+from phoebe.backend import mesh_cache
+
+def _mesh(n):
+  return {'vertices': np.arange(3.*n).reshape(n, 3), 'ntriangles': n}
+
+def _setup():
+  cache_dir = tempfile.mkdtemp()
+  phoebe.conf.mesh_cache_on(cache_dir)
+  mesh_cache._tracked_size.pop(phoebe.conf.mesh_cache_dir, None)
+  return phoebe.conf.mesh_cache_dir
+
+def _teardown(cache_dir, maxsize):
+  phoebe.conf.mesh_cache_off()
+  phoebe.conf.mesh_cache_set_maxsize(maxsize)
+  mesh_cache._tracked_size.pop(cache_dir, None)
+  shutil.rmtree(cache_dir, ignore_errors=True)
+
+def test_hit_miss(verbose=False):
+  maxsize = phoebe.conf.mesh_cache_maxsize
+  cache_dir = _setup()
+
+  try:
+    key = mesh_cache.key(0.5, 'roche', np.array([1., 2.]))
+    assert(mesh_cache.get(key) is None)
+
+    mesh_cache.put(key, _mesh(10), 2.5, (np.array([1., 2.]), 3.))
+
+    new_mesh, scale, mesh_args = mesh_cache.get(key)
+
+    if verbose:
+      print("hit {}: {} scale={} mesh_args={}".format(key, sorted(new_mesh.keys()), scale, mesh_args))
+
+    assert(np.all(new_mesh['vertices'] == _mesh(10)['vertices']))
+    assert(new_mesh['ntriangles'] == 10)
+    assert(scale == 2.5)
+    assert(np.all(mesh_args[0] == [1., 2.]) and mesh_args[1] == 3.)
+
+    # a different argument or a new MESH_VERSION is a miss
+    assert(mesh_cache.get(mesh_cache.key(0.6, 'roche', np.array([1., 2.]))) is None)
+
+    mesh_version = mesh_cache.MESH_VERSION
+    try:
+      mesh_cache.MESH_VERSION = mesh_version + 1
+      new_key = mesh_cache.key(0.5, 'roche', np.array([1., 2.]))
+    finally:
+      mesh_cache.MESH_VERSION = mesh_version
+
+    assert(new_key != key)
+    assert(mesh_cache.get(new_key) is None)
+
+    # the cache is not used when disabled
+    phoebe.conf.mesh_cache_off()
+    assert(mesh_cache.get(key) is None)
+  finally:
+    _teardown(cache_dir, maxsize)
+
+def test_evict(verbose=False):
+  maxsize = phoebe.conf.mesh_cache_maxsize
+  cache_dir = _setup()
+
+  try:
+    phoebe.conf.mesh_cache_set_maxsize(1)
+
+    # ~300kB each, so that three entries fit in 1MB
+    keys = [mesh_cache.key(i) for i in range(4)]
+    now = time.time()
+    for i, key in enumerate(keys[:3]):
+      mesh_cache.put(key, _mesh(12500), 1.)
+      os.utime(os.path.join(cache_dir, key), (now-300+100*i, now-300+100*i))
+
+    # the oldest entry is used again, so the second one is now the least
+    # recently used
+    assert(mesh_cache.get(keys[0]) is not None)
+
+    mesh_cache.put(keys[3], _mesh(12500), 1.)
+
+    entries = sorted(os.listdir(cache_dir))
+
+    if verbose:
+      print("entries: {}".format(entries))
+
+    assert(entries == sorted([keys[0], keys[2], keys[3]]))
+    assert(mesh_cache._tracked_size[cache_dir] <= mesh_cache._evict_fraction*1024**2)
+  finally:
+    _teardown(cache_dir, maxsize)
+
+def test_stale_tmp(verbose=False):
+  maxsize = phoebe.conf.mesh_cache_maxsize
+  cache_dir = _setup()
+
+  try:
+    mesh_cache.put(mesh_cache.key(0), _mesh(10), 1.)
+
+    stale = tempfile.mkdtemp(prefix='.tmp_', dir=cache_dir)
+    np.save(os.path.join(stale, 'vertices.npy'), np.zeros(10))
+    mtime = time.time() - 2*mesh_cache._tmp_timeout
+    os.utime(stale, (mtime, mtime))
+
+    # possibly still being written by another process
+    recent = tempfile.mkdtemp(prefix='.tmp_', dir=cache_dir)
+
+    size = mesh_cache._evict(cache_dir, 1024**2)
+
+    if verbose:
+      print("entries: {} size={}".format(os.listdir(cache_dir), size))
+
+    assert(not os.path.exists(stale))
+    assert(os.path.isdir(recent))
+    assert(os.path.isdir(os.path.join(cache_dir, mesh_cache.key(0))))
+    assert(size == mesh_cache._entry_size(os.path.join(cache_dir, mesh_cache.key(0))))
+  finally:
+    _teardown(cache_dir, maxsize)
+
+if __name__ == '__main__':
+  test_hit_miss(verbose=True)
+  test_evict(verbose=True)
+  test_stale_tmp(verbose=True)
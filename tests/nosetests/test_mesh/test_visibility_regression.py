@@ -0,0 +1,63 @@
+"""
+  Regression tests of the visibilities and weights of the triangles computed
+  by mesh_visibility: changes in the clipping must not change them beyond
+  round-off.
+
+"""
+
+import numpy as np
+import libphoebe
+
+# (q, F, d, Omega0, choice, ntriangles)
+_lobes = {'detached': (1, 1, 1, 10, 0, 1000),
+          'contact': (0.5, 0.5, 1, 2.65, 2, 2000)}
+
+# (lobe, method, viewing direction) and the visibilities and weights from
+# before the clipping engine was pooled: (number of partially visible
+# triangles, visible area, sum of the weights times the index of their vertex)
+_visibilities = {
+  ('detached', 'boolean', (0.0, 0.0, 1.0)): (0, 0.07730734295523432, 579.0),
+  ('detached', 'boolean', (0.6, 0.0, 0.8)): (0, 0.07711887453850826, 577.0),
+  ('detached', 'boolean', (0.96, 0.28, 0.0)): (0, 0.07735980016860527, 586.0),
+  ('detached', 'linear', (0.0, 0.0, 1.0)): (47, 0.076449888347311, 582.499596460799),
+  ('detached', 'linear', (0.6, 0.0, 0.8)): (47, 0.0760433371814574, 583.9517199593619),
+  ('detached', 'linear', (0.96, 0.28, 0.0)): (47, 0.07623839006882326, 588.4230400220483),
+  ('contact', 'boolean', (0.0, 0.0, 1.0)): (4, 1.8467502305559718, 1135.1051414996896),
+  ('contact', 'boolean', (0.6, 0.0, 0.8)): (9, 1.8174602017468613, 1127.7217254196808),
+  ('contact', 'boolean', (0.96, 0.28, 0.0)): (60, 1.5195856565902777, 978.6623701636574),
+  ('contact', 'linear', (0.0, 0.0, 1.0)): (87, 1.8268374202970752, 1139.9568224318111),
+  ('contact', 'linear', (0.6, 0.0, 0.8)): (98, 1.7971403889160333, 1136.9945637153685),
+  ('contact', 'linear', (0.96, 0.28, 0.0)): (139, 1.4949593397944727, 999.9587062625133)}
+
+def _mesh(q, F, d, Omega0, choice, ntriangles):
+  r_av = libphoebe.roche_area_volume(q, F, d, Omega0, choice, larea=True)
+  delta = np.sqrt(r_av["larea"]/(np.sqrt(3)*ntriangles/4))
+
+  return libphoebe.roche_marching_mesh(q, F, d, Omega0, delta, choice, int(1.5*ntriangles),
+                                       vertices=True, triangles=True, areas=True,
+                                       vnormals=True, tnormals=True)
+
+def test_visibilities(verbose=False):
+  meshes = {lobe: _mesh(*args) for lobe, args in _lobes.items()}
+
+  for (lobe, method, view), (npartial, area, wsum) in _visibilities.items():
+    r_mesh = meshes[lobe]
+
+    # the linear method interpolates mu from the normals at the vertices
+    normals = r_mesh["vnormals"] if method == 'linear' else r_mesh["tnormals"]
+
+    r = libphoebe.mesh_visibility(np.array(view), r_mesh["vertices"], r_mesh["triangles"], normals,
+                                  tvisibilities=True, taweights=True, method=method.encode())
+
+    v, w = r["tvisibilities"], r["taweights"]
+
+    if verbose:
+      print("{} {} {}: npartial={} area={} wsum={}".format(lobe, method, view, np.sum((v > 0) & (v < 1)), np.sum(v*r_mesh["areas"]), np.sum(w*np.arange(3))))
+
+    assert(np.all((v >= 0) & (v <= 1 + 1e-12)))
+    assert(np.sum((v > 0) & (v < 1)) == npartial)
+    assert(np.isclose(np.sum(v*r_mesh["areas"]), area, rtol=1e-12, atol=0))
+    assert(np.isclose(np.sum(w*np.arange(3)), wsum, rtol=1e-12, atol=0))
+
+if __name__ == '__main__':
+  test_visibilities(verbose=True)
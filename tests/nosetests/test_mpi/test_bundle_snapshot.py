@@ -0,0 +1,47 @@
+"""
+the binary snapshot of the bundle sent to the MPI workers (see
+backends._bundle_snapshot) must leave out models, solvers, solutions and
+figures, but keep everything else needed to compute the same model.
+"""
+import phoebe
+from phoebe.backend import backends
+from phoebe.frontend import binary
+import numpy as np
+
+
+def test_bundle_snapshot(verbose=False):
+    b = phoebe.default_binary()
+    b.add_dataset('lc', times=np.linspace(0,1,21), dataset='lc01')
+    b.set_value_all('irrad_method', 'none')
+
+    b.run_compute(model='first')
+    b.set_value('fluxes', dataset='lc01', context='dataset', value=b.get_value(qualifier='fluxes', model='first'))
+    b.add_solver('estimator.lc_geometry', solver='lcgeom')
+    b.run_solver(solver='lcgeom', solution='lcgeom_solution')
+    assert(set(['model', 'solver', 'solution', 'figure']).issubset(b.contexts))
+
+    snapshot = backends._bundle_snapshot(b)
+    assert(isinstance(snapshot, bytes))
+
+    # as in BaseBackend._run_worker
+    bw = phoebe.frontend.bundle.Bundle(binary.loads(snapshot))
+
+    if verbose:
+        print("contexts: {}, snapshot: {} bytes".format(bw.contexts, len(snapshot)))
+
+    for context in ['model', 'solver', 'solution', 'figure']:
+        assert(context not in bw.contexts)
+    assert(len(bw.to_list()) == len(b.exclude(context=['model', 'solver', 'solution', 'figure']).to_list()))
+    assert(np.all(bw.get_value(qualifier='fluxes', dataset='lc01', context='dataset') == b.get_value(qualifier='fluxes', dataset='lc01', context='dataset')))
+
+    b.set_value('incl', component='binary', value=80)
+    bw.set_value('incl', component='binary', value=80)
+    b.run_compute(model='original')
+    bw.run_compute(model='snapshot')
+    assert(np.allclose(bw.get_value(qualifier='fluxes', model='snapshot'), b.get_value(qualifier='fluxes', model='original'), rtol=1e-12, atol=0))
+
+
+if __name__ == '__main__':
+    logger = phoebe.logger(clevel='INFO')
+
+    test_bundle_snapshot(verbose=True)
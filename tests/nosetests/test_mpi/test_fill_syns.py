@@ -0,0 +1,102 @@
+"""
+assignment of the results gathered from the workers (see
+BaseBackend._fill_syns), emulated without MPI: the same results sent as
+packetlists, as columns, and as columns with mixed units must give the same
+synthetics.
+"""
+import phoebe
+from phoebe import u
+from phoebe.backend import backends
+import numpy as np
+
+
+def _packet_and_syns(b, backend, pblums_scale):
+    return backend.get_packet_and_syns(b, 'phoebe01', dataset=['lc01', 'rv01'], times=None, pblums_scale=pblums_scale)
+
+def test_fill_syns(verbose=False):
+    b = phoebe.default_binary()
+    b.add_dataset('lc', times=np.linspace(0,1,12), dataset='lc01')
+    b.add_dataset('rv', times=np.linspace(0,1,12), dataset='rv01')
+    b.set_value_all('irrad_method', 'none')
+
+    system, pblums_abs, pblums_scale, pblums_rel, pbfluxes = b.compute_pblums(compute='phoebe01', ret_structured_dicts=True, skip_checks=True)
+
+    backend = backends.PhoebeBackend()
+    packet, ref_syns = _packet_and_syns(b, backend, pblums_scale)
+    rpacketlists = backend._run_chunk(**packet)
+    ref_syns = backend._fill_syns(ref_syns, [rpacketlists])
+
+    # the rvs of every other time of the last worker in km/s, so that its
+    # columns of rvs cannot be collected into a single array
+    mixed_packetlists = [[dict(p, value=p['value'].to(u.km/u.s)) if p['qualifier']=='rvs' and i % 2 else p for p in packetlist]
+                         for i, packetlist in enumerate(rpacketlists[8:])]
+
+    # worker 0 (the master) sends packetlists, the others columns
+    rpacketlists_per_worker = [rpacketlists[:4],
+                               backends._packetlists_to_columns(rpacketlists[4:8]),
+                               backends._packetlists_to_columns(mixed_packetlists)]
+
+    assert(not isinstance(rpacketlists_per_worker[2][[c['qualifier'] for c in rpacketlists_per_worker[2]].index('rvs')]['values'], np.ndarray))
+
+    packet, new_syns = _packet_and_syns(b, backend, pblums_scale)
+    new_syns = backend._fill_syns(new_syns, rpacketlists_per_worker)
+
+    for qualifier, component in [('fluxes', None), ('rvs', 'primary'), ('rvs', 'secondary')]:
+        value = new_syns.get_value(qualifier=qualifier, component=component, unit=u.solRad/u.d if qualifier=='rvs' else None)
+        ref_value = ref_syns.get_value(qualifier=qualifier, component=component, unit=u.solRad/u.d if qualifier=='rvs' else None)
+
+        if verbose:
+            print("{}@{} max diff: {}".format(qualifier, component, np.max(np.abs(value-ref_value))))
+
+        assert(np.allclose(value, ref_value, rtol=1e-12, atol=0))
+
+
+def test_fill_syns_times(verbose=False):
+    b = phoebe.default_binary()
+    b.add_dataset('lc', times=np.linspace(0,1,12), dataset='lc01')
+    b.add_dataset('rv', times=np.linspace(0,1,12), dataset='rv01')
+    b.set_value_all('irrad_method', 'none')
+
+    system, pblums_abs, pblums_scale, pblums_rel, pbfluxes = b.compute_pblums(compute='phoebe01', ret_structured_dicts=True, skip_checks=True)
+
+    backend = backends.PhoebeBackend()
+    packet, ref_syns = _packet_and_syns(b, backend, pblums_scale)
+    rpacketlists = backend._run_chunk(**packet)
+    ref_syns = backend._fill_syns(ref_syns, [rpacketlists])
+
+    # times that differ from those of the synthetics only in the last bits
+    # (ie. after round-trips through other units) are still matched
+    columns = backends._packetlists_to_columns(rpacketlists)
+    for column in columns:
+        column['times'] = np.nextafter(np.nextafter(column['times'], 2), 2)
+
+    packet, new_syns = _packet_and_syns(b, backend, pblums_scale)
+    new_syns = backend._fill_syns(new_syns, [columns])
+
+    for qualifier, component in [('fluxes', None), ('rvs', 'primary'), ('rvs', 'secondary')]:
+        value = new_syns.get_value(qualifier=qualifier, component=component)
+        ref_value = ref_syns.get_value(qualifier=qualifier, component=component)
+
+        if verbose:
+            print("{}@{} max diff: {}".format(qualifier, component, np.max(np.abs(value-ref_value))))
+
+        assert(np.all(value == ref_value))
+
+    # values at times not in the synthetics are not dropped silently
+    for column in columns:
+        column['times'] = column['times'] + 1e-3
+
+    packet, new_syns = _packet_and_syns(b, backend, pblums_scale)
+    try:
+        backend._fill_syns(new_syns, [columns])
+    except ValueError:
+        pass
+    else:
+        raise AssertionError("expected ValueError for unmatched times")
+
+
+if __name__ == '__main__':
+    logger = phoebe.logger(clevel='INFO')
+
+    test_fill_syns(verbose=True)
+    test_fill_syns_times(verbose=True)
@@ -0,0 +1,73 @@
+"""
+needs to be run with mpirun -np 4 python test_mpi_backend.py
+
+compares the model computed by all ranks (times dealt out dynamically,
+bundle sent to the workers as a binary snapshot, results gathered as
+columns from the workers and packetlists from rank 0) to the model computed
+serially afterwards.
+"""
+import phoebe
+from phoebe import u
+import numpy as np
+
+
+def test_mpi_backend(verbose=False, npoints=31):
+    b = phoebe.Bundle.default_binary()
+    b.set_value('q', 0.8)
+    b.set_value('ecc', 0.2)
+
+    b.add_dataset('lc', times=np.linspace(0,1,npoints), dataset='lc01')
+    b.add_dataset('rv', times=np.linspace(0,1,npoints), dataset='rv01')
+    b.add_dataset('mesh', times=[0, 0.25], columns=['teffs', 'areas'], dataset='mesh01')
+    b.set_value_all('irrad_method', 'none')
+    b.add_compute('phoebe', irrad_method='none', enabled=False, compute='nmcompute')
+    b.set_value('enabled', dataset='lc01', compute='nmcompute', value=True)
+
+    # the existing model and solution are left out of the snapshot sent to
+    # the workers
+    b.run_compute(model='first')
+    b.set_value('fluxes', dataset='lc01', context='dataset', value=b.get_value(qualifier='fluxes', model='first'))
+    b.add_solver('optimizer.nelder_mead', fit_parameters=['incl@binary'], maxiter=2, solver='nm')
+    b.run_solver(solver='nm', compute='nmcompute', solution='nm_solution')
+
+    if verbose: print("calling compute within mpirun")
+    b.set_value('incl', component='binary', value=80)
+    b.run_compute(model='mpimodel')
+
+    # the workers are not needed anymore, all following computations are serial
+    phoebe.mpi.shutdown_workers()
+
+    if verbose: print("calling compute serially")
+    b.run_compute(model='serialmodel')
+
+    for qualifier, component, dataset, unit in [('fluxes', None, 'lc01', None),
+                                                ('rvs', 'primary', 'rv01', u.km/u.s),
+                                                ('rvs', 'secondary', 'rv01', u.km/u.s)]:
+        value = b.get_value(qualifier=qualifier, component=component, dataset=dataset, model='mpimodel', unit=unit)
+        serial_value = b.get_value(qualifier=qualifier, component=component, dataset=dataset, model='serialmodel', unit=unit)
+
+        if verbose:
+            print("{}@{} max diff: {}".format(qualifier, component, np.max(np.abs(value-serial_value))))
+
+        assert(np.allclose(value, serial_value, rtol=0, atol=1e-12))
+
+    for time in [0, 0.25]:
+        for component in ['primary', 'secondary']:
+            for qualifier in ['teffs', 'areas']:
+                value = b.get_value(qualifier=qualifier, component=component, time=time, dataset='mesh01', model='mpimodel')
+                serial_value = b.get_value(qualifier=qualifier, component=component, time=time, dataset='mesh01', model='serialmodel')
+                assert(np.allclose(value, serial_value, rtol=1e-12, atol=0))
+
+    return b
+
+# disable testing within nosetests/Travis
+test_mpi_backend.__test__ = False
+
+if __name__ == '__main__':
+    # for fair timing comparisons, let's disable checking for online passbands
+    import os
+    os.environ['PHOEBE_ENABLE_ONLINE_PASSBANDS'] = 'FALSE'
+
+    logger = phoebe.logger(clevel='WARNING')
+
+    b = test_mpi_backend(verbose=True)
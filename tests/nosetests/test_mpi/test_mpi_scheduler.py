@@ -0,0 +1,81 @@
+"""
+test_plan runs within nosetests, test_scheduler needs to be run with
+mpirun -np 4 python test_mpi_scheduler.py
+"""
+import os
+# the ranks are driven by this script instead of waiting for packets from
+# rank 0 (must be set before importing phoebe)
+os.environ['PHOEBE_ENABLE_MPI'] = 'FALSE'
+
+import phoebe
+from phoebe.backend import scheduler
+import numpy as np
+import time
+
+
+def test_plan(verbose=False):
+    costs = np.random.RandomState(1).uniform(1, 10, 101)
+    for nprocs in [1, 3, 4]:
+        chunks, chunk_costs, bounds = scheduler.plan(costs, nprocs)
+
+        # all times exactly once, in chunks of consecutive times
+        assert(np.all(np.sort(np.concatenate(chunks)) == np.arange(len(costs))))
+        assert(np.all([np.all(np.diff(chunk) == 1) for chunk in chunks]))
+        assert(np.allclose(chunk_costs, [costs[chunk].sum() for chunk in chunks]))
+
+        # contiguous queues covering all chunks, with about the same cost
+        assert(bounds[0,0] == 0 and bounds[-1,1] == len(chunks))
+        assert(np.all(bounds[1:,0] == bounds[:-1,1]))
+        loads = np.array([chunk_costs[head:tail].sum() for head, tail in bounds])
+        if verbose:
+            print("nprocs={} loads={}".format(nprocs, loads))
+        assert(loads.max() - loads.min() <= chunk_costs.max())
+
+    # fewer times than ranks
+    chunks, chunk_costs, bounds = scheduler.plan([1., 2.], 4)
+    assert(len(chunks) == 2)
+    assert(np.sum(bounds[:,1]-bounds[:,0]) == 2)
+
+    chunks, chunk_costs, bounds = scheduler.plan([], 4)
+    assert(len(chunks) == 0)
+    assert(np.all(bounds == 0))
+
+def test_scheduler(verbose=False, ntimes=203):
+    comm = phoebe.mpi.comm
+    myrank = comm.Get_rank()
+
+    # rank 1 is much slower than estimated, so the others have to steal
+    # from its queue
+    costs = np.ones(ntimes) if myrank == 0 else None
+    inds = scheduler.TimeScheduler(costs, comm)
+    taken = []
+    for i in inds:
+        taken.append(i)
+        time.sleep(0.02 if myrank == 1 else 0.002)
+    ntaken, nstolen = inds.ntaken, inds.nstolen
+    inds.free()
+
+    results = comm.gather((taken, ntaken, nstolen), root=0)
+    if myrank != 0:
+        return
+
+    taken = np.concatenate([r[0] for r in results]).astype(int)
+    if verbose:
+        for rank, r in enumerate(results):
+            print("rank:{} took {} times, stole {} chunks".format(rank, len(r[0]), r[2]))
+
+    # every time computed by exactly one rank
+    assert(np.all(np.sort(taken) == np.arange(ntimes)))
+    # the count of taken times is shared by all ranks
+    assert(max([r[1] for r in results]) == ntimes)
+    # the slow rank computed fewer times and its chunks were stolen
+    assert(len(results[1][0]) < ntimes / len(results))
+    assert(sum([r[2] for r in results]) > 0)
+
+# disable testing within nosetests/Travis
+test_scheduler.__test__ = False
+
+if __name__ == '__main__':
+    test_plan(verbose=phoebe.mpi.myrank == 0)
+    if phoebe.mpi.within_mpirun:
+        test_scheduler(verbose=True)
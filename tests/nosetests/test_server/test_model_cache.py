@@ -0,0 +1,83 @@
+"""
+run_compute requests to phoebe-server with the same parameters as a model in
+its model cache must not compute again, but be served as a detached job that
+is already complete, loaded under the label of the new request by
+attach_job.
+"""
+import phoebe
+import numpy as np
+import os
+from importlib.machinery import SourceFileLoader
+from importlib.util import spec_from_loader, module_from_spec
+
+
+def _load_server():
+    fname = os.path.join(os.path.dirname(__file__), '..', '..', '..', 'client-server', 'phoebe-server')
+    loader = SourceFileLoader('phoebe_server', os.path.abspath(fname))
+    server = module_from_spec(spec_from_loader('phoebe_server', loader))
+    loader.exec_module(server)
+    return server
+
+def test_model_cache_hit(verbose=False):
+    server = _load_server()
+    # the server turns off interactive checks and constraints for the process,
+    # restore the defaults for this (and any following) test
+    phoebe.interactive_constraints_on()
+    phoebe.interactive_checks_off()
+
+    app = server.app
+    app._maxcomputations = 0
+    app._disable_solvers = False
+    app._model_cache = server.ModelCache()
+
+    b = phoebe.default_binary()
+    b.add_dataset('lc', times=np.linspace(0,1,11), dataset='lc01')
+    b.set_value_all('irrad_method', 'none')
+    b.run_compute(model='original')
+    fluxes = b.get_value(qualifier='fluxes', model='original', context='model')
+
+    bundleid = 'TESTBUNDLE'
+    app._bundles[bundleid] = b
+    app._log_per_bundle[bundleid] = server.Log()
+
+    # as stored when loading the job of a cache miss (see attach_job)
+    model_ps = b.filter(context='model', model='original')
+    app._model_cache.add(server._model_cache_key(b, [], {'compute': 'phoebe01'}), model_ps.to_json(incl_uniqueid=False))
+
+    def run_compute(*args, **kwargs):
+        raise AssertionError("cache hit should not call run_compute")
+    b.run_compute = run_compute
+
+    client = server.socketio.test_client(app)
+    client.emit('bundle_method', {'bundleid': bundleid, 'method': 'run_compute', 'compute': 'phoebe01', 'model': 'fromcache'})
+    del b.run_compute
+
+    errors = [r for r in client.get_received() if 'errors' in r['name']]
+    assert(not len(errors))
+    assert(app._model_cache.stats['hits'] == 1)
+
+    job_param = b.get_parameter(qualifier='detached_job', model='fromcache', context='model')
+    assert(job_param.get_status() == 'complete')
+    assert(os.path.exists(job_param._results_fname))
+
+    client.emit('bundle_method', {'bundleid': bundleid, 'method': 'attach_job', 'uniqueid': job_param.uniqueid})
+    errors = [r for r in client.get_received() if 'errors' in r['name']]
+    assert(not len(errors))
+
+    if verbose:
+        print(b.filter(model='fromcache', context='model'))
+
+    # relabeled to the model of the request, the cached model is untouched
+    assert(job_param.get_status() == 'loaded')
+    assert(not os.path.exists(job_param._results_fname))
+    assert('fromcache' in b.models and 'original' in b.models)
+    assert(np.all(b.get_value(qualifier='fluxes', model='fromcache', context='model') == fluxes))
+    assert(np.all(b.get_value(qualifier='fluxes', model='original', context='model') == fluxes))
+    assert(b.filter(model='fromcache', context='model').computes == ['phoebe01'])
+
+    client.disconnect()
+
+if __name__ == '__main__':
+    logger = phoebe.logger(clevel='INFO')
+
+    test_model_cache_hit(verbose=True)
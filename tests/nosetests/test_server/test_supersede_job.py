@@ -0,0 +1,82 @@
+"""
+a run_compute request to phoebe-server for a model whose detached job is
+still running supersedes that job, but the old job may only be killed once
+the new job has been accepted.
+"""
+import phoebe
+import numpy as np
+import os
+from importlib.machinery import SourceFileLoader
+from importlib.util import spec_from_loader, module_from_spec
+
+
+def _load_server():
+    fname = os.path.join(os.path.dirname(__file__), '..', '..', '..', 'client-server', 'phoebe-server')
+    loader = SourceFileLoader('phoebe_server', os.path.abspath(fname))
+    server = module_from_spec(spec_from_loader('phoebe_server', loader))
+    loader.exec_module(server)
+    return server
+
+def _job(b, model):
+    return b.get_parameter(qualifier='detached_job', model=model, context='model', check_visible=False)
+
+def test_supersede_job(verbose=False):
+    server = _load_server()
+    # the server turns off interactive checks and constraints for the process,
+    # restore the defaults for this (and any following) test
+    phoebe.interactive_constraints_on()
+    phoebe.interactive_checks_off()
+
+    app = server.app
+    app._maxcomputations = 0
+    app._disable_solvers = False
+    app._model_cache = server.ModelCache(max_entries=0)
+
+    b = phoebe.default_binary()
+    # long enough to still be running when the next requests come in
+    b.add_dataset('lc', times=np.linspace(0,10,2001), dataset='lc01')
+
+    bundleid = 'TESTBUNDLE'
+    app._bundles[bundleid] = b
+    app._log_per_bundle[bundleid] = server.Log()
+    app._clients_per_bundle[bundleid] = ['web-test']
+
+    client = server.socketio.test_client(app)
+    client.emit('bundle_method', {'bundleid': bundleid, 'method': 'run_compute', 'compute': 'phoebe01', 'model': 'mymodel'})
+    old_job = _job(b, 'mymodel')
+    assert(old_job.get_status() not in ['complete', 'loaded', 'error', 'killed'])
+    client.get_received()
+
+    # a request that fails leaves the old job running
+    client.emit('bundle_method', {'bundleid': bundleid, 'method': 'run_compute', 'compute': 'phoebe01', 'model': 'mymodel', 'not_a_kwarg': 1})
+    errors = [r for r in client.get_received() if 'errors' in r['name']]
+    if verbose:
+        print(errors)
+    assert(len(errors))
+    assert(_job(b, 'mymodel') is old_job)
+    assert(old_job.get_status() not in ['complete', 'loaded', 'error', 'killed'])
+    assert(b.models == ['mymodel'])
+
+    # an accepted request kills the old job
+    client.emit('bundle_method', {'bundleid': bundleid, 'method': 'run_compute', 'compute': 'phoebe01', 'model': 'mymodel'})
+    received = client.get_received()
+    errors = [r for r in received if 'errors' in r['name']]
+    assert(not len(errors))
+    new_job = _job(b, 'mymodel')
+    assert(new_job is not old_job)
+    assert(old_job.get_status() == 'killed')
+    assert(b.models == ['mymodel'])
+
+    # and the clients are told that its parameters were removed
+    removed = [uniqueid for r in received if 'changes' in r['name'] for uniqueid in r['args'][0].get('removed_parameters', [])]
+    if verbose:
+        print("removed: {}".format(removed))
+    assert(old_job.uniqueid in removed)
+
+    new_job.kill(cleanup=True)
+    client.disconnect()
+
+if __name__ == '__main__':
+    logger = phoebe.logger(clevel='INFO')
+
+    test_supersede_job(verbose=True)